@@ -42,6 +42,9 @@ bool inMenu = false;
 // Flag that indicates a screen refresh is required
 bool refreshScreen = true;
 
+// Flag that indicates menu has been fully drawn on screen, next updates could be partial
+bool menuDrawn = false;
+
 // Messages for non-menu display operations
 const char *incr = "incr button";
 const char *decr = "decr button";
@@ -193,18 +196,29 @@ void screen_render()
     if (!refreshScreen)
         return;
 
+    if (inMenu && menuDrawn)
+    {
+        // menu is already on screen, redraw only changed items and send to display changed tiles only
+        if (muiplus.refresh())
+            muipp::u8g2_update_regions(u8g2, muiplus.getDirtyRegions());
+        refreshScreen = false;
+        return;
+    }
+
     u8g2_ClearBuffer(&u8g2);
 
     if (inMenu)
     {
         // printf("Render menu\n");
         muiplus.render();
+        menuDrawn = true;
     }
     else
     {
         // printf("Render welcome screen\n");
         u8g2_SetFont(&u8g2, SMALL_TEXT_FONT);
         u8g2_DrawStr(&u8g2, 0, u8g2_GetDisplayHeight(&u8g2) / 2, stub_text);
+        menuDrawn = false;
     }
 
     u8g2_SendBuffer(&u8g2);
@@ -234,4 +248,10 @@ void setup_menu()
         root_page);
 
     muiplus.menuStart(root_page);
+
+    // menu will clear areas of the items that needs a redraw on partial screen refreshes
+    muiplus.setClearCallback([](const muipp::rect_t &rect)
+                             { muipp::u8g2_clear_rect(u8g2, rect); });
+    // dirty regions are clipped to the screen
+    muiplus.setDisplaySize(u8g2_GetDisplayWidth(&u8g2), u8g2_GetDisplayHeight(&u8g2));
 }
@@ -24,6 +24,7 @@
 #include "main.h"
 #include "pico/stdlib.h"
 #include "u8g2functions.h"
+#include "u8g2flusher.h"
 #include <Versatile_RotaryEncoder.h>
 #include <u8g2.h>
 
@@ -45,10 +46,20 @@ const char *quitmenu = "menu closed";
 
 const char *stub_text = anyk;
 
+// when built with MUIPP_RECORD_EVENTS user input is printed to stdout as an events log,
+// it could be replayed on a host with muipp_replay tool from host_simulator example
+static mui_event record(mui_event e){
+#ifdef MUIPP_RECORD_EVENTS
+  muipp::event_log_write(stdout, muipp::clock_ms(), e);
+#endif
+  return e;
+}
+
 // Constructor, will create buttons object members, assigning pins to it
 DisplayControls::DisplayControls() : encoder(ROTARY_clk, ROTARY_dt, ROTARY_sw) {
   // u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_i2c, u8x8_gpio_and_delay_hw_i2c);
-  u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_i2c, u8x8_gpio_and_delay_hw_i2c);
+  // display data is sent over I2C with DMA in background
+  u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_i2c_dma, u8x8_gpio_and_delay_hw_i2c);
 }
 
 /**
@@ -89,20 +100,32 @@ void DisplayControls::handleLongPressRelease() {
     // so the idea is - Menu Object is instantiated in memory ONLY when I'm entering menu and released on quit
     _menu = std::make_unique<MuiPlusPlus>();
     _buildMenu();
+    // menu will clear areas of the items that needs a redraw on partial screen refreshes
+    _menu->setClearCallback([this](const muipp::rect_t& rect){ muipp::u8g2_clear_rect(u8g2, rect); });
+    // dirty regions are clipped to the screen
+    _menu->setDisplaySize(u8g2_GetDisplayWidth(&u8g2), u8g2_GetDisplayHeight(&u8g2));
+    // static items are drawn once and copied back from cache on next page visits
+    _menu->setRenderCache(&_cache);
     // set the flag, indicating that now I have menu object created for this same _evt_button() function would know to redirect further "OK" keypresses to menu from now on
     _inMenu = true;
   } else {
+    // process pending encoder moves first to keep events order
+    _menu->processEvents();
     // we are already in Menu,
     // so I'm sending 'escape' mui_event there to _menu object, and save what event I receive in return to this press
     // let's save it as 'e' object (a mui_event structure)
-    auto e = _menu->muiEvent(mui_event(mui_event_t::escape));
+    auto e = _menu->muiEvent(record(mui_event(mui_event_t::escape)));
 
     // Now I need to check if I received a reply with 'quitMenu' event back from menu object
     // if that is so then I need to switch to Main Work Screen since menu has exited, long press will always quit Menu to main screen
     if (e.eid == mui_event_t::quitMenu) {
+#if MUIPP_PROFILING
+      // print timing statistics collected while menu was open
+      _menu->profiler().dump();
+#endif
       // release our menu object - i.e. destruct it, releasing all memory
       if (_menu)
-        _menu.release();
+        _menu.reset();
       // set flag to indicate we are no longer in menu
       _inMenu = false;
       // change a message we print on a screen
@@ -121,6 +144,8 @@ void DisplayControls::begin() {
   u8g2_InitDisplay(&u8g2);
   u8g2_SetPowerSave(&u8g2, 0);
   u8g2_SendBuffer(&u8g2);
+  // from now on frame buffer is sent to display by core1, core0 keeps handling input and rendering
+  u8g2_flusher_begin(&u8g2);
 }
 
 /**
@@ -137,9 +162,11 @@ DisplayControls::~DisplayControls() {
  * 
  */
 void DisplayControls::_menu_ok_action() {
-  auto e = _menu->muiEvent(mui_event(mui_event_t::enter));
+  // process pending encoder moves first to keep events order
+  _menu->processEvents();
+  auto e = _menu->muiEvent(record(mui_event(mui_event_t::enter)));
   if (e.eid == mui_event_t::quitMenu) {
-    _menu.release();
+    _menu.reset();
     _inMenu = false;
     stub_text = quitmenu;
     // printf("menu object destroyed\n");
@@ -150,11 +177,16 @@ void DisplayControls::_menu_encoder_action(int8_t rotation) {
   // we are in menu, let's send "encoder" events to menu
   // I do not care about returned events from menu for encoder buttons presses for now because I know that
   // menu could quit only on "OK" button press or longPress
+  // moves are queued and processed in a batch on next screen redraw, so that fast encoder spins won't cause a render per detent
+  bool queued = true;
   if (rotation == Versatile_RotaryEncoder::Rotary::right) {
-    _menu->muiEvent(mui_event(mui_event_t::moveUp));
+    queued = _menu->postEvent(record(mui_event(mui_event_t::moveUp)));
   } else if (rotation == Versatile_RotaryEncoder::Rotary::left) {
-    _menu->muiEvent(mui_event(mui_event_t::moveDown));
+    queued = _menu->postEvent(record(mui_event(mui_event_t::moveDown)));
   }
+  // cursor moves are kept even when queue is full, so this should not happen, but let's know if it does
+  if (!queued)
+    printf("menu events queue is full, encoder event dropped\n");
 }
 
 
@@ -166,18 +198,40 @@ void DisplayControls::_menu_encoder_action(int8_t rotation) {
  */
 void DisplayControls::drawScreen() {
   encoder.ReadEncoder();
+  // process queued encoder moves
+  if (_inMenu && _menu)
+    _menu->processEvents();
+  // previous frame is still being sent, keep handling input and render on next call,
+  // running animations will skip the frame
+  if (u8g2_flusher_busy()) return;
+
+  if (_inMenu && _menu && _menu_drawn) {
+    // menu is already on screen, redraw only changed or animated items and send to display changed tiles only
+    if (_menu->refresh()){
+#if MUIPP_PROFILING
+      // time spent on core0 to hand the frame over to the flusher
+      muipp::prof_scope p(_menu->profiler(), muipp::prof_kind_t::flush, 0);
+#endif
+      u8g2_flusher_commit(&u8g2, &_menu->getDirtyRegions());
+    }
+    _rr = false;
+    return;
+  }
   if (!_rr) return;
 
-  u8g2_ClearBuffer(&u8g2);
   if (_inMenu && _menu) {
+    u8g2_ClearBuffer(&u8g2);
     // printf("Render menu:%lu ms\n", to_ms_since_boot(get_absolute_time()));
     _menu->render();
+    _menu_drawn = true;
   } else {
+    u8g2_ClearBuffer(&u8g2);
     // printf("Render welcome screen\n");
     u8g2_SetFont(&u8g2, SMALL_TEXT_FONT);
     u8g2_DrawStr(&u8g2, 0, u8g2_GetDisplayHeight(&u8g2) / 2, stub_text);
+    _menu_drawn = false;
   }
-  u8g2_SendBuffer(&u8g2);
+  u8g2_flusher_commit(&u8g2);
 
   _rr = false;
 }
@@ -202,11 +256,12 @@ void DisplayControls::drawScreen() {
  * 
  */
 void DisplayControls::_buildMenu() {
+  // items are placed in menu's memory arena, it is released at once when menu object is destroyed
   muiItemId root_page = _menu->makePage(lang_en_us::T_Settings);
-  _menu->addMuippItem(new MuiItem_U8g2_PageTitle(u8g2, _menu->nextIndex(), PAGE_TITLE_FONT_SMALL), root_page);
+  _menu->addMuippItem(_menu->makeItem<MuiItem_U8g2_PageTitle>(u8g2, _menu->nextIndex(), PAGE_TITLE_FONT_SMALL), root_page);
 
   muiItemId scroll_list_id = _menu->nextIndex();
-  auto list = new MuiItem_U8g2_DynamicScrollList(
+  auto list = _menu->makeItem<MuiItem_U8g2_DynamicScrollList>(
       u8g2,
       scroll_list_id,
       [](size_t index) { return menu_MainConfiguration.at(index); },
@@ -217,6 +272,10 @@ void DisplayControls::_buildMenu() {
       MAIN_MENU_FONT3, MAIN_MENU_FONT3);
 
   list->listopts.page_selector = true;
+  // scroll the list smoothly
+  list->listopts.scroll_time = 120;
+  // labels are static strings, so those could be kept between renders
+  list->listopts.cache_labels = true;
   list->listopts.back_on_last = true;
   list->on_escape = mui_event_t::quitMenu;
 
@@ -224,10 +283,10 @@ void DisplayControls::_buildMenu() {
   _menu->pageAutoSelect(root_page, scroll_list_id);
 
   muiItemId title2_id = _menu->nextIndex();
-  _menu->addMuippItem(new MuiItem_U8g2_PageTitle(u8g2, title2_id, PAGE_TITLE_FONT));
+  _menu->addMuippItem(_menu->makeItem<MuiItem_U8g2_PageTitle>(u8g2, title2_id, PAGE_TITLE_FONT));
 
   muiItemId quit_idx = _menu->nextIndex();
-  auto quitbtn = new MuiItem_U8g2_ActionButton(
+  auto quitbtn = _menu->makeItem<MuiItem_U8g2_ActionButton>(
       u8g2,
       quit_idx,
       mui_event_t::escape,
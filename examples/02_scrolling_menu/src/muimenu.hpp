@@ -44,6 +44,12 @@ private:
   // in-Menu state flag
   bool _inMenu{false};
 
+  // menu has been fully drawn on screen, next updates could be partial
+  bool _menu_drawn{false};
+
+  // images of menu's static items (titles, buttons), declared before menu object to outlive it
+  muipp::u8g2_render_cache _cache{u8g2, 512};
+
   // a placeholder for our MuiPlusPlus menu object, initially empty
   std::unique_ptr<MuiPlusPlus> _menu;
 
@@ -21,6 +21,7 @@
 #include "main.h"
 #include "muimenu.hpp"
 #include "u8g2functions.h"
+#include "u8g2flusher.h"
 #include <u8g2.h>
 
 
@@ -45,7 +46,8 @@ const char* stub_text = anyk;
 
 DisplayControls::DisplayControls(): encoder(ROTARY_clk, ROTARY_dt, ROTARY_sw) {
   // u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_i2c, u8x8_gpio_and_delay_hw_i2c);
-  u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_i2c, u8x8_gpio_and_delay_hw_i2c);
+  // display data is sent over I2C with DMA in background
+  u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_i2c_dma, u8x8_gpio_and_delay_hw_i2c);
 };
 
   void DisplayControls::handleRotate(int8_t rotation) {
@@ -80,10 +82,16 @@ DisplayControls::DisplayControls(): encoder(ROTARY_clk, ROTARY_dt, ROTARY_sw) {
       // for this I'm creating an instance of MuiPlusPlus object
       // so the idea is - Menu Object is instantiated in memory ONLY when I'm entering menu and released on quit
       _menu = std::make_unique<TemperatureSetup>(u8g2, encoder);
+      // menu will clear areas of the items that needs a redraw on partial screen refreshes
+      _menu->setClearCallback([this](const muipp::rect_t& rect){ muipp::u8g2_clear_rect(u8g2, rect); });
+      // dirty regions are clipped to the screen
+      _menu->setDisplaySize(u8g2_GetDisplayWidth(&u8g2), u8g2_GetDisplayHeight(&u8g2));
       // _menu->_buildMenu(u8g2);
       // set the flag, indicating that now I have menu object created for this same _evt_button() function would know to redirect further "OK" keypresses to menu from now on
       _inMenu = true;
     } else {
+      // process pending encoder moves first to keep events order
+      _menu->processEvents();
       // we are already in Menu,
       // so I'm sending 'escape' mui_event there to _menu object, and save what event I receive in return to this press
       // let's save it as 'e' object (a mui_event structure)
@@ -94,7 +102,7 @@ DisplayControls::DisplayControls(): encoder(ROTARY_clk, ROTARY_dt, ROTARY_sw) {
       if (e.eid == mui_event_t::quitMenu) {
         // release our menu object - i.e. destruct it, releasing all memory
         if (_menu)
-          _menu.release();
+          _menu.reset();
         // set flag to indicate we are no longer in menu
         _inMenu = false;
         // change a message we print on a screen
@@ -114,6 +122,8 @@ void DisplayControls::begin(){
   u8g2_InitDisplay(&u8g2);
   u8g2_SetPowerSave(&u8g2, 0);
   u8g2_SendBuffer(&u8g2);
+  // from now on frame buffer is sent to display by core1, core0 keeps handling input and rendering
+  u8g2_flusher_begin(&u8g2);
 }
 
 DisplayControls::~DisplayControls(){
@@ -128,11 +138,13 @@ DisplayControls::~DisplayControls(){
  */
 void DisplayControls::_menu_ok_action(){
   // we are in menu, let's send "enter" menu to it and check return event
+  // process pending encoder moves first to keep events order
+  _menu->processEvents();
   auto e = _menu->muiEvent( mui_event(mui_event_t::enter) );
   // check if menu has quit in responce to button event,
   // if quit, then I'll destroy menu object 
   if (e.eid == mui_event_t::quitMenu){
-    _menu.release();
+    _menu.reset();
     _inMenu = false;
     stub_text = quitmenu;
     // printf("menu object destroyed\n");
@@ -148,29 +160,51 @@ void DisplayControls::_menu_encoder_action(int8_t rotation) {
   // we are in menu, let's send "encoder" events to menu
   // I do not care about returned events from menu for encoder buttons presses for now because I know that
   // menu could quit only on "OK" button press or longPress
+  // moves are queued and processed in a batch on next screen redraw, so that fast encoder spins won't cause a render per detent
+  bool queued = true;
   if (rotation == Versatile_RotaryEncoder::Rotary::right) {
-    _menu->muiEvent(mui_event(mui_event_t::moveUp));
+    queued = _menu->postEvent(mui_event(mui_event_t::moveUp));
   } else if (rotation == Versatile_RotaryEncoder::Rotary::left) {
-    _menu->muiEvent(mui_event(mui_event_t::moveDown));
+    queued = _menu->postEvent(mui_event(mui_event_t::moveDown));
   }
+  // cursor moves are kept even when queue is full, so this should not happen, but let's know if it does
+  if (!queued)
+    printf("menu events queue is full, encoder event dropped\n");
 }
 
 
 
 void DisplayControls::drawScreen(){
   encoder.ReadEncoder();
+  // process queued encoder moves
+  if (_inMenu && _menu)
+    _menu->processEvents();
+  // previous frame is still being sent, keep handling input and render on next call,
+  // running animations will skip the frame
+  if (u8g2_flusher_busy()) return;
+
+  if (_inMenu && _menu && _menu_drawn) {
+    // menu is already on screen, redraw only changed or animated items and send to display changed tiles only
+    if (_menu->refresh())
+      u8g2_flusher_commit(&u8g2, &_menu->getDirtyRegions());
+    _rr = false;
+    return;
+  }
   if (!_rr) return;
 
-  u8g2_ClearBuffer(&u8g2);
   if (_inMenu && _menu) {
+    u8g2_ClearBuffer(&u8g2);
     // printf("Render menu:%lu ms\n", to_ms_since_boot(get_absolute_time()));
     _menu->render();
+    _menu_drawn = true;
   } else {
+    u8g2_ClearBuffer(&u8g2);
     // printf("Render welcome screen\n");
     u8g2_SetFont(&u8g2, SMALL_TEXT_FONT);
     u8g2_DrawStr(&u8g2, 0, u8g2_GetDisplayHeight(&u8g2) / 2, stub_text);
+    _menu_drawn = false;
   }
-  u8g2_SendBuffer(&u8g2);
+  u8g2_flusher_commit(&u8g2);
 
   _rr = false;
 }
@@ -236,19 +270,19 @@ void TemperatureSetup::_buildMenu(u8g2_t &u8g2){
     I use arrays because later on I will create menuItems with a loop
   
   */
-  constexpr std::array<int32_t, menu_TemperatureOpts.size()-2> def_temp_min = {
+  static constexpr std::array<int32_t, menu_TemperatureOpts.size()-2> def_temp_min = {
     TEMP_MIN,
     TEMP_STANDBY_MIN,
     TEMP_BOOST_MIN
   };
 
-  constexpr std::array<int32_t, menu_TemperatureOpts.size()-2> def_temp_max = {
+  static constexpr std::array<int32_t, menu_TemperatureOpts.size()-2> def_temp_max = {
     TEMP_MAX,
     TEMP_STANDBY_MAX,
     TEMP_BOOST_MAX
   };
 
-  constexpr std::array<int32_t, menu_TemperatureOpts.size()-2> def_temp_step = {
+  static constexpr std::array<int32_t, menu_TemperatureOpts.size()-2> def_temp_step = {
     TEMP_STEP,
     TEMP_STANDBY_STEP,
     TEMP_BOOST_STEP
@@ -292,6 +326,8 @@ void TemperatureSetup::_buildMenu(u8g2_t &u8g2){
     to search and switch to the page with same 'name'
   */
   list->listopts.page_selector = true;
+  // scroll the list smoothly
+  list->listopts.scroll_time = 120;
 
   // this flag means that last item of a list will act as 'back' event, and will try to retuen to the previous page/item
   list->listopts.back_on_last = true;
@@ -324,30 +360,37 @@ void TemperatureSetup::_buildMenu(u8g2_t &u8g2){
   */
 
   // autogenerate items for each temperature setting value, number of items are equal to number of array elements I control
+  // pages are lazy - slider is created only when page is opened, and destroyed when memory budget set below is exceeded
   for (auto i = 0; i != _temp.size(); ++i){
     // make page, bound to root page with a title from a scroll list menu
-    muiItemId page = makePage(menu_TemperatureOpts.at(i), root_page);
-    // add page title element, that same one object we created recently
-    addItemToPage(title2_id, page);
-    // create num slider Mui Item
-    muiItemId idx = nextIndex();
-    auto hslide = new MuiItem_U8g2_NumberHSlide<int32_t> (
-      u8g2, idx,
-      nullptr,        // label is not needed, we already created page title element
-      _temp.at(i),    // current temp value reference, it will be updated on by the SLider on "action" event
-      def_temp_min[i], def_temp_max[i], def_temp_step[i],   // constrains
-      nullptr,        // print unformatted numeric value callbak
-      nullptr, nullptr, nullptr,    // no callbacks required here, for details pls check MuiItem_U8g2_NumberHSlide declaration
-      NUMERIC_FONT1, MAIN_MENU_FONT2,   // set two fonts for selected and neighbouring values on a Slider
-      u8g2_GetDisplayWidth(&u8g2)/2, u8g2_GetDisplayHeight(&u8g2)/2, NUMBERSLIDE_X_OFFSET   // location on screen where to print the numbers
-    );
-    // since this item is the only active on the page, return to prev page on unselect
-    hslide->on_escape = mui_event_t::prevPage;
-    // add num slider to page
-    addMuippItem(hslide, page);
-    // make this item autoselected on this page
-    pageAutoSelect(page, idx);
+    makePage(menu_TemperatureOpts.at(i), root_page, [this, &u8g2, i, title2_id](MuiPlusPlus& menu, muiItemId page){
+      // add page title element, that same one object we created recently
+      addItemToPage(title2_id, page);
+      // create num slider Mui Item
+      muiItemId idx = nextIndex();
+      // sliders are created in menu's memory arena, memory chunk of an evicted slider is reused for the next one
+      auto hslide = menu.makeItem<MuiItem_U8g2_NumberHSlide<int32_t>> (
+        u8g2, idx,
+        nullptr,        // label is not needed, we already created page title element
+        _temp.at(i),    // current temp value reference, it will be updated on by the SLider on "action" event
+        def_temp_min[i], def_temp_max[i], def_temp_step[i],   // constrains
+        nullptr,        // print unformatted numeric value callbak
+        nullptr, nullptr, nullptr,    // no callbacks required here, for details pls check MuiItem_U8g2_NumberHSlide declaration
+        NUMERIC_FONT1, MAIN_MENU_FONT2,   // set two fonts for selected and neighbouring values on a Slider
+        u8g2_GetDisplayWidth(&u8g2)/2, u8g2_GetDisplayHeight(&u8g2)/2, NUMBERSLIDE_X_OFFSET   // location on screen where to print the numbers
+      );
+      // since this item is the only active on the page, return to prev page on unselect
+      hslide->on_escape = mui_event_t::prevPage;
+      // speed up value changes when encoder is turned faster than 20 detents per second
+      hslide->accel.threshold = 20;
+      // add num slider to page
+      addMuippItem(hslide, page);
+      // make this item autoselected on this page
+      pageAutoSelect(page, idx);
+    });
   }
+  // keep only one slider page in memory at a time
+  setPagesBudget(1);
 
   // ***
   // now I need a page with checkbox "Save last Work temp"
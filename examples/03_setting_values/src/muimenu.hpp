@@ -46,6 +46,9 @@ class DisplayControls {
   // in Menu flag
   bool _inMenu{false};
 
+  // menu has been fully drawn on screen, next updates could be partial
+  bool _menu_drawn{false};
+
   // a placeholder for our menu object, initially empty
   std::unique_ptr<MuiMenu> _menu;
 
@@ -0,0 +1,168 @@
+/*
+    This file is a part of MuiPlusPlus project
+    https://github.com/vortigont/MuiPlusPlus
+
+    Copyright © 2024-2025 Emil Muratov (vortigont)
+
+    MuiPlusPlus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MuiPlusPlus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MuiPlusPlus.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host benchmark for MuiPlusPlus
+
+  Menu is rendered to u8g2 full frame buffer of a 128x64 display, display transport just counts bytes sent,
+  so this measures pure CPU time of menu construction, rendering and event dispatching.
+  Numbers are only meaningful relative to each other on the same host, use it to catch regressions.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "muipp_u8g2.hpp"
+
+#define MENU_FONT   u8g2_font_6x10_tf
+#define SLIDER_FONT u8g2_font_10x20_tf
+
+using bench_clock = std::chrono::steady_clock;
+
+static u8g2_t u8g2;
+// number of bytes sent to display
+static size_t bytes_sent;
+
+// menu labels and values, must persist while menu exists
+static std::vector<std::string> labels;
+static std::vector<int32_t> values;
+
+// display byte transport that discards data and just counts bytes
+static uint8_t u8x8_byte_count(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr){
+  if (msg == U8X8_MSG_BYTE_SEND)
+    bytes_sent += arg_int;
+  return 1;
+}
+
+/**
+ * @brief build a menu similar to example 03 - root page with a scroll list of 'size' entries,
+ * each entry leads to a page with numeric slider
+ * 
+ * @param size number of list entries / pages
+ * @return std::unique_ptr<MuiPlusPlus> 
+ */
+static std::unique_ptr<MuiPlusPlus> build_menu(size_t size){
+  auto menu = std::make_unique<MuiPlusPlus>();
+  menu->reserve(size + 3, size + 1);
+  muiItemId root = menu->makePage("Settings");
+  menu->addMuippItem(new MuiItem_U8g2_PageTitle(u8g2, menu->nextIndex(), MENU_FONT), root);
+
+  muiItemId list_id = menu->nextIndex();
+  auto list = new MuiItem_U8g2_DynamicScrollList(u8g2, list_id,
+    [](size_t index){ return labels.at(index).c_str(); },
+    [](){ return labels.size(); },
+    nullptr,
+    12, 4,      // y shift, rows
+    0, 14,      // x, y
+    MENU_FONT, MENU_FONT);
+  list->listopts.page_selector = true;
+  // labels are owned by a vector that is not changed while menu runs
+  list->listopts.cache_labels = true;
+  menu->addMuippItem(list, root);
+  menu->pageAutoSelect(root, list_id);
+
+  muiItemId title_id = menu->nextIndex();
+  menu->addMuippItem(new MuiItem_U8g2_PageTitle(u8g2, title_id, MENU_FONT));
+
+  for (size_t i = 0; i != size; ++i){
+    muiItemId page = menu->makePage(labels.at(i).c_str(), root);
+    menu->addItemToPage(title_id, page);
+    muiItemId idx = menu->nextIndex();
+    auto slider = new MuiItem_U8g2_NumberHSlide<int32_t>(u8g2, idx, nullptr, values.at(i), 0, 500, 1,
+      nullptr, nullptr, nullptr, nullptr,
+      SLIDER_FONT, MENU_FONT,
+      u8g2_GetDisplayWidth(&u8g2) / 2, u8g2_GetDisplayHeight(&u8g2) / 2, 10);
+    slider->on_escape = mui_event_t::prevPage;
+    menu->addMuippItem(slider, page);
+    menu->pageAutoSelect(page, idx);
+  }
+
+  menu->menuStart(root);
+  menu->setClearCallback([](const muipp::rect_t& rect){ muipp::u8g2_clear_rect(u8g2, rect); });
+  menu->setDisplaySize(u8g2_GetDisplayWidth(&u8g2), u8g2_GetDisplayHeight(&u8g2));
+  return menu;
+}
+
+// run function 'iterations' times and print average time and display traffic per call
+template <typename F>
+static void bench(const char* name, size_t size, size_t iterations, F&& f){
+  bytes_sent = 0;
+  auto t = bench_clock::now();
+  for (size_t i = 0; i != iterations; ++i)
+    f();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t).count();
+  printf("%-24s %6zu %12.2f %10zu\n", name, size, static_cast<double>(ns) / iterations / 1000, bytes_sent / iterations);
+}
+
+int main(){
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_dummy_cb);
+  u8g2_InitDisplay(&u8g2);
+
+  printf("%-24s %6s %12s %10s\n", "test", "items", "us/op", "bytes/op");
+
+  for (size_t size : {10, 100, 1000}){
+    labels.clear();
+    for (size_t i = 0; i != size; ++i)
+      labels.emplace_back("Entry " + std::to_string(i));
+    values.assign(size, 250);
+
+    bench("construct", size, 20000 / size, [size](){ build_menu(size); });
+
+    auto menu = build_menu(size);
+
+    bench("render", size, 2000, [&menu](){ u8g2_ClearBuffer(&u8g2); menu->render(); });
+
+    bench("event moveDown", size, 20000, [&menu](){ menu->muiEvent(mui_event(mui_event_t::moveDown)); });
+
+    bench("refresh idle", size, 20000, [&menu](){ menu->refresh(); });
+
+    bench("moveDown + refresh", size, 2000, [&menu](){
+      menu->muiEvent(mui_event(mui_event_t::moveDown));
+      menu->refresh();
+    });
+
+    bench("moveDown + partial send", size, 2000, [&menu](){
+      menu->muiEvent(mui_event(mui_event_t::moveDown));
+      if (menu->refresh())
+        muipp::u8g2_update_regions(u8g2, menu->getDirtyRegions());
+    });
+
+    bench("queued 8 moves + refresh", size, 2000, [&menu](){
+      for (int i = 0; i != 8; ++i)
+        menu->postEvent(mui_event(mui_event_t::moveDown));
+      menu->processEvents();
+      menu->refresh();
+    });
+
+    bench("page enter + back", size, 2000, [&menu](){
+      menu->muiEvent(mui_event(mui_event_t::enter));
+      menu->refresh();
+      menu->muiEvent(mui_event(mui_event_t::prevPage));
+      menu->refresh();
+    });
+
+    bench("full frame send", size, 2000, [](){ u8g2_SendBuffer(&u8g2); });
+  }
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*
+    This file is a part of MuiPlusPlus project
+    https://github.com/vortigont/MuiPlusPlus
+
+    Copyright © 2024-2025 Emil Muratov (vortigont)
+
+    MuiPlusPlus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MuiPlusPlus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MuiPlusPlus.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host menu simulator for MuiPlusPlus
+
+  Runs menus of examples 02 and 03 on a host against U8g2's in-memory frame buffer of a 128x64 SH1106 display,
+  driving them with a scripted sequence of events. Each updated frame could be saved as a PBM image,
+  frames per second and number of bytes changed/sent per frame are reported, so it could be run in CI
+  to track rendering performance and catch visual regressions without a device.
+
+  Usage: muipp_simulator [scroll|temperature] [script] [output dir]
+  script is a string of events: u - moveUp, d - moveDown, e - enter, x - escape, . - idle frame
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "menus.hpp"
+
+using sim_clock = std::chrono::steady_clock;
+
+// default script walks through the list, opens pages, changes values and returns back
+static constexpr const char* default_script = "ddduuueddddduuuxdeuuuxdedx.ddeeddx";
+
+// save current frame buffer to outdir/frame_NNNN.pbm
+static void save_frame(const char* outdir, size_t n){
+  char path[256];
+  std::snprintf(path, sizeof(path), "%s/frame_%04zu.pbm", outdir, n);
+  std::FILE* f = std::fopen(path, "wb");
+  if (!f){
+    std::fprintf(stderr, "can't write %s\n", path);
+    return;
+  }
+  muipp::u8g2_write_pbm(u8g2, f);
+  std::fclose(f);
+}
+
+static mui_event_t script_event(char c){
+  switch (c){
+    case 'u' : return mui_event_t::moveUp;
+    case 'd' : return mui_event_t::moveDown;
+    case 'e' : return mui_event_t::enter;
+    case 'x' : return mui_event_t::escape;
+    default  : return mui_event_t::noop;
+  }
+}
+
+int main(int argc, char* argv[]){
+  const char* name = argc > 1 ? argv[1] : "temperature";
+  const char* script = argc > 2 ? argv[2] : default_script;
+  const char* outdir = argc > 3 ? argv[3] : nullptr;
+
+  sim_display_begin();
+  const size_t buf_size = u8g2_GetBufferTileWidth(&u8g2) * u8g2_GetBufferTileHeight(&u8g2) * 8;
+  std::vector<uint8_t> prev(buf_size);
+
+  auto menu = build_menu(name);
+
+  size_t frames{0}, changed{0};
+  sim_clock::duration cpu{};
+  bytes_sent = 0;
+
+  // first frame is a full render, next ones are partial refreshes
+  auto t = sim_clock::now();
+  u8g2_ClearBuffer(&u8g2);
+  menu->render();
+  u8g2_SendBuffer(&u8g2);
+  cpu += sim_clock::now() - t;
+
+  // count bytes changed since previous frame and save the frame
+  auto capture = [&](){
+    const uint8_t* buf = u8g2_GetBufferPtr(&u8g2);
+    for (size_t i = 0; i != buf_size; ++i)
+      changed += buf[i] != prev[i];
+    std::memcpy(prev.data(), buf, buf_size);
+    if (outdir)
+      save_frame(outdir, frames);
+    ++frames;
+  };
+  capture();
+
+  for (const char* c = script; *c; ++c){
+    t = sim_clock::now();
+    mui_event e = menu->muiEvent(mui_event(script_event(*c)));
+    if (e.eid == mui_event_t::quitMenu){
+      std::printf("menu quit at script position %zu\n", static_cast<size_t>(c - script));
+      break;
+    }
+    bool updated = menu->refresh();
+    if (updated)
+      muipp::u8g2_update_regions(u8g2, menu->getDirtyRegions());
+    cpu += sim_clock::now() - t;
+    if (updated)
+      capture();
+  }
+
+  double us = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(cpu).count()) / 1000;
+  std::printf("menu:          %s\n", name);
+  std::printf("frames:        %zu\n", frames);
+  std::printf("us/frame:      %.2f\n", us / frames);
+  std::printf("frames/s:      %.0f\n", us ? frames * 1e6 / us : 0);
+  std::printf("changed/frame: %zu bytes\n", changed / frames);
+  std::printf("sent/frame:    %zu bytes\n", bytes_sent / frames);
+  return 0;
+}
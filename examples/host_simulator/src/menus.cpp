@@ -0,0 +1,140 @@
+/*
+    This file is a part of MuiPlusPlus project
+    https://github.com/vortigont/MuiPlusPlus
+
+    Copyright © 2024-2025 Emil Muratov (vortigont)
+
+    MuiPlusPlus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MuiPlusPlus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MuiPlusPlus.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "menus.hpp"
+#include "literals.h"
+
+u8g2_t u8g2;
+// number of bytes sent to display
+size_t bytes_sent;
+
+// temperature values and a checkbox state controlled by menu
+static std::array<int32_t, 3> temps = { 300, 200, 400 };
+static bool save_work{false};
+
+// display byte transport that discards data and just counts bytes
+static uint8_t u8x8_byte_count(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr){
+  if (msg == U8X8_MSG_BYTE_SEND)
+    bytes_sent += arg_int;
+  return 1;
+}
+
+// scrolling menu from example 02, root page with a list leading to stub pages
+std::unique_ptr<MuiPlusPlus> build_scroll_menu(){
+  auto menu = std::make_unique<MuiPlusPlus>();
+  muiItemId root_page = menu->makePage(lang_en_us::T_Settings);
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_PageTitle>(u8g2, menu->nextIndex(), PAGE_TITLE_FONT_SMALL), root_page);
+
+  muiItemId list_id = menu->nextIndex();
+  auto list = menu->makeItem<MuiItem_U8g2_DynamicScrollList>(u8g2, list_id,
+    [](size_t index){ return menu_MainConfiguration.at(index); },
+    [](){ return menu_MainConfiguration.size(); },
+    nullptr,
+    MAIN_MENU_Y_SHIFT, MAIN_MENU_ROWS,
+    MAIN_MENU_X_OFFSET, MAIN_MENU_Y_OFFSET,
+    MAIN_MENU_FONT3, MAIN_MENU_FONT3);
+  list->listopts.page_selector = true;
+  list->listopts.back_on_last = true;
+  list->on_escape = mui_event_t::quitMenu;
+  menu->addMuippItem(list, root_page);
+  menu->pageAutoSelect(root_page, list_id);
+
+  muiItemId title_id = menu->nextIndex();
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_PageTitle>(u8g2, title_id, PAGE_TITLE_FONT));
+  muiItemId quit_id = menu->nextIndex();
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_ActionButton>(u8g2, quit_id, mui_event_t::escape, "Return back", SMALL_TEXT_FONT,
+    u8g2_GetDisplayWidth(&u8g2) / 2, u8g2_GetDisplayHeight(&u8g2) / 2, muipp::text_align_t::center, muipp::text_align_t::bottom));
+
+  for (size_t i = 0; i != menu_MainConfiguration.size() - 1; ++i){
+    muiItemId page = menu->makePage(menu_MainConfiguration.at(i), root_page);
+    menu->addItemToPage(title_id, page);
+    menu->addItemToPage(quit_id, page);
+    menu->pageAutoSelect(page, quit_id);
+  }
+
+  menu->menuStart(root_page);
+  return menu;
+}
+
+// temperature setup menu from example 03, a list leading to pages with sliders and a checkbox
+std::unique_ptr<MuiPlusPlus> build_temperature_menu(){
+  static constexpr std::array<int32_t, 3> temp_min = { TEMP_MIN, TEMP_STANDBY_MIN, TEMP_BOOST_MIN };
+  static constexpr std::array<int32_t, 3> temp_max = { TEMP_MAX, TEMP_STANDBY_MAX, TEMP_BOOST_MAX };
+  static constexpr std::array<int32_t, 3> temp_step = { TEMP_STEP, TEMP_STANDBY_STEP, TEMP_BOOST_STEP };
+
+  auto menu = std::make_unique<MuiPlusPlus>();
+  muiItemId root_page = menu->makePage(menu_MainConfiguration.at(0));
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_PageTitle>(u8g2, menu->nextIndex(), PAGE_TITLE_FONT_SMALL), root_page);
+
+  muiItemId list_id = menu->nextIndex();
+  auto list = menu->makeItem<MuiItem_U8g2_DynamicScrollList>(u8g2, list_id,
+    [](size_t index){ return menu_TemperatureOpts.at(index); },
+    [](){ return menu_TemperatureOpts.size(); },
+    nullptr,
+    MAIN_MENU_Y_SHIFT, MAIN_MENU_ROWS,
+    MAIN_MENU_X_OFFSET, MAIN_MENU_Y_OFFSET,
+    MAIN_MENU_FONT3, MAIN_MENU_FONT3);
+  list->listopts.page_selector = true;
+  list->listopts.back_on_last = true;
+  list->on_escape = mui_event_t::quitMenu;
+  menu->addMuippItem(list, root_page);
+  menu->pageAutoSelect(root_page, list_id);
+
+  muiItemId title_id = menu->nextIndex();
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_PageTitle>(u8g2, title_id, PAGE_TITLE_FONT));
+
+  for (size_t i = 0; i != temps.size(); ++i){
+    muiItemId page = menu->makePage(menu_TemperatureOpts.at(i), root_page);
+    menu->addItemToPage(title_id, page);
+    muiItemId idx = menu->nextIndex();
+    auto hslide = menu->makeItem<MuiItem_U8g2_NumberHSlide<int32_t>>(u8g2, idx, nullptr, temps.at(i),
+      temp_min[i], temp_max[i], temp_step[i],
+      nullptr, nullptr, nullptr, nullptr,
+      NUMERIC_FONT1, MAIN_MENU_FONT2,
+      u8g2_GetDisplayWidth(&u8g2) / 2, u8g2_GetDisplayHeight(&u8g2) / 2, NUMBERSLIDE_X_OFFSET);
+    hslide->on_escape = mui_event_t::prevPage;
+    menu->addMuippItem(hslide, page);
+    menu->pageAutoSelect(page, idx);
+  }
+
+  muiItemId page = menu->makePage(menu_TemperatureOpts.at(menu_TemperatureOpts.size() - 2), root_page);
+  menu->addItemToPage(title_id, page);
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_CheckBox>(u8g2, menu->nextIndex(), dictionary[D_SaveLast_box], save_work,
+    [](size_t v){ save_work = v; }, MAINSCREEN_FONT, 0, 35), page);
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_StaticText>(u8g2, menu->nextIndex(), dictionary[D_SaveLast_hint], MAIN_MENU_FONT1, 0, 45), page);
+  menu->addMuippItem(menu->makeItem<MuiItem_U8g2_BackButton>(u8g2, menu->nextIndex(), dictionary[D_return], MAIN_MENU_FONT1), page);
+
+  menu->menuStart(root_page);
+  return menu;
+}
+
+void sim_display_begin(){
+  u8g2_Setup_sh1106_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_dummy_cb);
+  u8g2_InitDisplay(&u8g2);
+}
+
+std::unique_ptr<MuiPlusPlus> build_menu(const char* name){
+  auto menu = std::strcmp(name, "scroll") ? build_temperature_menu() : build_scroll_menu();
+  menu->setClearCallback([](const muipp::rect_t& rect){ muipp::u8g2_clear_rect(u8g2, rect); });
+  menu->setDisplaySize(u8g2_GetDisplayWidth(&u8g2), u8g2_GetDisplayHeight(&u8g2));
+  return menu;
+}
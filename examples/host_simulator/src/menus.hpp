@@ -0,0 +1,52 @@
+/*
+    This file is a part of MuiPlusPlus project
+    https://github.com/vortigont/MuiPlusPlus
+
+    Copyright © 2024-2025 Emil Muratov (vortigont)
+
+    MuiPlusPlus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MuiPlusPlus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MuiPlusPlus.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Menus of examples 02 and 03 built for a host, shared by the simulator and replay tools.
+  Menus are rendered to U8g2's in-memory frame buffer of a 128x64 SH1106 display,
+  display transport does not send anything but counts bytes
+*/
+
+#pragma once
+#include <memory>
+#include "muipp_u8g2.hpp"
+
+// display object menus are drawn to
+extern u8g2_t u8g2;
+// number of bytes sent to display
+extern size_t bytes_sent;
+
+// set up display with in-memory buffer
+void sim_display_begin();
+
+// scrolling menu from example 02, root page with a list leading to stub pages
+std::unique_ptr<MuiPlusPlus> build_scroll_menu();
+
+// temperature setup menu from example 03, a list leading to pages with sliders and a checkbox
+std::unique_ptr<MuiPlusPlus> build_temperature_menu();
+
+/**
+ * @brief build menu by name, with clear callback set for partial refreshes
+ * 
+ * @param name "scroll" or "temperature"
+ * @return std::unique_ptr<MuiPlusPlus> 
+ */
+std::unique_ptr<MuiPlusPlus> build_menu(const char* name);
@@ -0,0 +1,151 @@
+/*
+    This file is a part of MuiPlusPlus project
+    https://github.com/vortigont/MuiPlusPlus
+
+    Copyright © 2024-2025 Emil Muratov (vortigont)
+
+    MuiPlusPlus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MuiPlusPlus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MuiPlusPlus.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Events log replay for MuiPlusPlus
+
+  Feeds a recorded events log (written with muipp::event_log_write() on a device) into a menu on a host.
+  Library clock is driven by event timestamps, so animations, input acceleration, etc... behave same way
+  on each run regardless of host speed. Between events menu is refreshed at MUIPP_FRAME_TIME_MS intervals,
+  like a device's render loop does. Events with the same timestamp are queued and processed in a batch.
+
+  Reports event dispatch latency, refresh time, number of frames and item renders and refresh() hit rate,
+  run it before and after a change to compare.
+
+  Usage: muipp_replay [scroll|temperature] <events log>
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "menus.hpp"
+
+using sim_clock = std::chrono::steady_clock;
+
+// simulated time, ms
+static uint32_t sim_ms;
+
+struct log_entry_t {
+  uint32_t ms;
+  mui_event e;
+};
+
+// time statistics, us
+struct stat_t {
+  std::vector<double> v;
+
+  void add(sim_clock::duration d){ v.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) / 1000); }
+
+  void print(const char* name){
+    if (v.empty()) return;
+    std::sort(v.begin(), v.end());
+    double sum{0};
+    for (auto x : v) sum += x;
+    std::printf("%-16s min %8.2f  avg %8.2f  p95 %8.2f  max %8.2f us\n", name, v.front(), sum / v.size(), v[v.size() * 95 / 100], v.back());
+  }
+};
+
+int main(int argc, char* argv[]){
+  if (argc < 3){
+    std::printf("Usage: %s [scroll|temperature] <events log>\n", argv[0]);
+    return 1;
+  }
+
+  std::FILE* f = std::fopen(argv[2], "r");
+  if (!f){
+    std::fprintf(stderr, "can't open %s\n", argv[2]);
+    return 1;
+  }
+  std::vector<log_entry_t> log;
+  char line[128];
+  for (size_t n = 1; std::fgets(line, sizeof(line), f); ++n){
+    if (line[0] == '#' || line[0] == '\n') continue;
+    log_entry_t entry;
+    if (muipp::event_log_parse(line, entry.ms, entry.e) != mui_err_t::ok){
+      std::fprintf(stderr, "skip malformed line %zu: %s", n, line);
+      continue;
+    }
+    log.push_back(entry);
+  }
+  std::fclose(f);
+  if (log.empty()) return 1;
+
+  // library takes time from event timestamps
+  sim_ms = log.front().ms;
+  muipp::set_clock([](){ return sim_ms; });
+
+  sim_display_begin();
+  auto menu = build_menu(argv[1]);
+  u8g2_ClearBuffer(&u8g2);
+  menu->render();
+
+  stat_t dispatch, refresh;
+  size_t polls{0}, frames{0}, dropped{0};
+
+  // refresh display like a render loop does
+  auto poll = [&](stat_t* s){
+    auto t = sim_clock::now();
+    bool updated = menu->refresh();
+    if (updated)
+      muipp::u8g2_update_regions(u8g2, menu->getDirtyRegions());
+    if (s) s->add(sim_clock::now() - t);
+    ++polls;
+    frames += updated;
+  };
+
+  for (auto i = log.cbegin(); i != log.cend(); ++i){
+    // idle frames until event's time
+    while (static_cast<int32_t>(i->ms - sim_ms) >= MUIPP_FRAME_TIME_MS){
+      sim_ms += MUIPP_FRAME_TIME_MS;
+      poll(nullptr);
+    }
+    sim_ms = i->ms;
+    if (!menu->postEvent(i->e))
+      ++dropped;
+    // events that came within the same ms are processed together
+    if (i + 1 != log.cend() && i[1].ms == i->ms) continue;
+
+    auto t = sim_clock::now();
+    mui_event reply = menu->processEvents();
+    dispatch.add(sim_clock::now() - t);
+    poll(&refresh);
+    if (reply.eid == mui_event_t::quitMenu){
+      std::printf("menu quit at %lu ms\n", static_cast<unsigned long>(i->ms));
+      break;
+    }
+  }
+
+  std::printf("events:          %zu, dropped on full queue %zu\n", log.size(), dropped);
+  std::printf("replayed time:   %lu ms\n", static_cast<unsigned long>(sim_ms - log.front().ms));
+  dispatch.print("event dispatch");
+  refresh.print("refresh");
+  std::printf("frames:          %zu\n", frames);
+  std::printf("refresh() calls: %zu, hit rate %.1f%%\n", polls, polls ? frames * 100.0 / polls : 0);
+#if MUIPP_PROFILING
+  size_t renders{0};
+  for (const auto &s : menu->profiler())
+    if (s.kind == muipp::prof_kind_t::render)
+      renders += s.count;
+  std::printf("item renders:    %zu\n", renders);
+#endif
+  return 0;
+}
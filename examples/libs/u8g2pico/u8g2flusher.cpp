@@ -0,0 +1,105 @@
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include "muipp_u8g2.hpp"
+#include "u8g2flusher.h"
+
+#if defined(LIB_PICO_MULTICORE)
+#include "pico/multicore.h"
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// copy of display object that points to the front buffer, used by worker only
+static u8g2_t front;
+static std::vector<uint8_t> front_buf;
+// areas to send, empty list means whole buffer
+static muipp::region_list_t front_regions;
+static std::atomic<bool> busy{false};
+
+#if !defined(LIB_PICO_MULTICORE)
+// worker signaling, it is never released since worker thread runs until program exit
+struct flusher_sync {
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool pending{false};
+};
+static flusher_sync *fsync{nullptr};
+#endif
+
+static void flush_front(){
+    if (front_regions.empty())
+        u8g2_SendBuffer(&front);
+    else
+        muipp::u8g2_update_regions(front, front_regions);
+    busy.store(false, std::memory_order_release);
+}
+
+#if defined(LIB_PICO_MULTICORE)
+static void flusher_core1() {
+    while (true) {
+        // wait for commit
+        multicore_fifo_pop_blocking();
+        flush_front();
+    }
+}
+#else
+static void flusher_thread() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(fsync->mtx);
+        fsync->cv.wait(lock, []{ return fsync->pending; });
+        fsync->pending = false;
+        lock.unlock();
+        flush_front();
+    }
+}
+#endif
+
+void u8g2_flusher_begin(u8g2_t *u8g2) {
+    // front display object shares display setup and callbacks with the original one
+    front = *u8g2;
+    front_buf.assign(8 * u8g2_GetBufferTileHeight(u8g2) * u8g2_GetBufferTileWidth(u8g2), 0);
+    front.tile_buf_ptr = front_buf.data();
+    front_regions.reserve(8);
+#if defined(LIB_PICO_MULTICORE)
+    multicore_launch_core1(flusher_core1);
+#else
+    fsync = new flusher_sync;
+    std::thread(flusher_thread).detach();
+#endif
+}
+
+void u8g2_flusher_commit(u8g2_t *u8g2, const muipp::region_list_t *regions) {
+    u8g2_flusher_wait();
+    std::memcpy(front_buf.data(), u8g2_GetBufferPtr(u8g2), front_buf.size());
+    if (regions)
+        front_regions.assign(regions->begin(), regions->end());
+    else
+        front_regions.clear();
+    busy.store(true, std::memory_order_release);
+#if defined(LIB_PICO_MULTICORE)
+    multicore_fifo_push_blocking(0);
+#else
+    {
+        std::lock_guard<std::mutex> lock(fsync->mtx);
+        fsync->pending = true;
+    }
+    fsync->cv.notify_one();
+#endif
+}
+
+bool u8g2_flusher_busy() {
+    return busy.load(std::memory_order_acquire);
+}
+
+void u8g2_flusher_wait() {
+    while (busy.load(std::memory_order_acquire)) {
+#if defined(LIB_PICO_MULTICORE)
+        tight_loop_contents();
+#else
+        std::this_thread::yield();
+#endif
+    }
+}
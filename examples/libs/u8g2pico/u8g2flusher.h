@@ -0,0 +1,40 @@
+#ifndef U8G2FLUSHER_H
+#define U8G2FLUSHER_H
+#include <u8g2.h>
+#include "muipp_tpl.hpp"
+
+/*
+  Double buffered display flusher
+
+  Frame buffer is transmitted to the display by a worker running on core1 (Pico multicore FIFO is used for signaling)
+  or on a separate thread on host builds, so that UI logic on core0 never waits for the bus transfer.
+  On commit the rendered buffer is copied to a front buffer owned by the worker, the rendered buffer stays intact,
+  so menu could keep drawing on top of it incrementally (i.e. with MuiPlusPlus::refresh()).
+
+  Once flusher is started, all bus operations must go through it, display object must not be used to talk to the display directly.
+*/
+
+/**
+ * @brief start flush worker
+ * display must be set up in full buffer mode and initialized prior to this call
+ * 
+ * @param u8g2 display object to render to
+ */
+void u8g2_flusher_begin(u8g2_t *u8g2);
+
+/**
+ * @brief copy rendered buffer to the front buffer and request it's transmission to the display
+ * if previous transmission is still in progress, call will wait for it to finish
+ * 
+ * @param u8g2 display object to render to
+ * @param regions screen areas to update, nullptr or empty list - send whole buffer
+ */
+void u8g2_flusher_commit(u8g2_t *u8g2, const muipp::region_list_t *regions = nullptr);
+
+// returns true if transmission is in progress
+bool u8g2_flusher_busy();
+
+// wait for current transmission to finish
+void u8g2_flusher_wait();
+
+#endif
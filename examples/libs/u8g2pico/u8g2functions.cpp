@@ -1,5 +1,8 @@
 #include <pico/stdlib.h>
+#include <hardware/dma.h>
 #include <hardware/i2c.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
 #include <u8g2.h>
 
 // Define I2C pins for Raspberry Pi Pico
@@ -54,6 +57,148 @@ uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
     }
 }
 
+/*
+  DMA driven I2C transport
+
+  Bytes are staged into a ring of I2C data_cmd words, each transfer ends with a word carrying STOP bit,
+  so that the ring could be fed to I2C TX FIFO by DMA as a continuous stream of transfers.
+  Completed transfers are handed over to DMA on U8X8_MSG_BYTE_END_TRANSFER and callback returns immediately,
+  DMA IRQ handler keeps sending ring segments until all staged data is sent. A whole frame fits into the ring,
+  so u8g2_SendBuffer() returns as soon as frame is staged.
+*/
+
+// staging ring size in data_cmd words, must be a power of 2
+#define I2C_DMA_RING_WORDS 2048
+
+static uint16_t dma_ring[I2C_DMA_RING_WORDS];
+// next word to write, modified by producer only
+static uint32_t ring_head;
+// end of staged data that could be sent
+static volatile uint32_t ring_commit;
+// start of data not yet sent, modified by DMA IRQ handler
+static volatile uint32_t ring_tail;
+// number of words in DMA segment in flight, 0 - DMA is idle
+static volatile uint32_t dma_count;
+static int dma_chan = -1;
+static spin_lock_t *dma_lock;
+static uint8_t dma_addr = 0xff;
+
+// start DMA on next contiguous segment of committed data, must be called with dma_lock held
+static void dma_start_segment() {
+    uint32_t avail = ring_commit - ring_tail;
+    if (!avail) {
+        dma_count = 0;
+        return;
+    }
+    uint32_t pos = ring_tail & (I2C_DMA_RING_WORDS - 1);
+    dma_count = MIN(avail, I2C_DMA_RING_WORDS - pos);
+    dma_channel_transfer_from_buffer_now(dma_chan, &dma_ring[pos], dma_count);
+}
+
+static void dma_irq_handler() {
+    if (!dma_channel_get_irq0_status(dma_chan))
+        return;
+    dma_channel_acknowledge_irq0(dma_chan);
+    // clear possible transfer abort (i.e. NACK), otherwise controller keeps TX FIFO flushed
+    (void)i2c_get_hw(I2C_PORT)->clr_tx_abrt;
+    uint32_t s = spin_lock_blocking(dma_lock);
+    ring_tail = ring_tail + dma_count;
+    dma_start_segment();
+    spin_unlock(dma_lock, s);
+}
+
+// hand over staged data up to 'end' to DMA
+static void dma_commit(uint32_t end) {
+    uint32_t s = spin_lock_blocking(dma_lock);
+    ring_commit = end;
+    if (!dma_count)
+        dma_start_segment();
+    spin_unlock(dma_lock, s);
+}
+
+static void ring_put(uint16_t w) {
+    if (ring_head - ring_tail >= I2C_DMA_RING_WORDS) {
+        // ring is full with a transfer in progress, let DMA send it, last word is kept back since it might need a STOP bit
+        // I2C master holds the bus while TX FIFO is empty and no STOP is issued
+        dma_commit(ring_head - 1);
+        while (ring_head - ring_tail >= I2C_DMA_RING_WORDS)
+            tight_loop_contents();
+    }
+    dma_ring[ring_head & (I2C_DMA_RING_WORDS - 1)] = w;
+    ++ring_head;
+}
+
+static void hardware_i2c_dma_init() {
+    hardware_i2c_init();
+    dma_lock = spin_lock_init(spin_lock_claim_unused(true));
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(I2C_PORT, true));
+    dma_channel_configure(dma_chan, &c, &i2c_get_hw(I2C_PORT)->data_cmd, dma_ring, 0, false);
+    dma_channel_set_irq0_enabled(dma_chan, true);
+    irq_add_shared_handler(DMA_IRQ_0, dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+bool u8x8_byte_hw_i2c_dma_busy() {
+    return ring_tail != ring_head || (i2c_get_hw(I2C_PORT)->status & (I2C_IC_STATUS_TFE_BITS | I2C_IC_STATUS_MST_ACTIVITY_BITS)) != I2C_IC_STATUS_TFE_BITS;
+}
+
+void u8x8_byte_hw_i2c_dma_wait() {
+    while (u8x8_byte_hw_i2c_dma_busy())
+        tight_loop_contents();
+}
+
+// DMA driven I2C implementation for u8x8_byte callback
+uint8_t u8x8_byte_hw_i2c_dma(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr) {
+    static uint32_t xfer_start;
+
+    switch (msg) {
+        case U8X8_MSG_BYTE_INIT:
+            hardware_i2c_dma_init();
+            return 1;
+
+        case U8X8_MSG_BYTE_START_TRANSFER: {
+            uint8_t addr = u8x8_GetI2CAddress(u8x8) >> 1; // 7-bit I2C address
+            if (addr != dma_addr) {
+                // target address could be changed only when controller is idle
+                u8x8_byte_hw_i2c_dma_wait();
+                i2c_get_hw(I2C_PORT)->enable = 0;
+                i2c_get_hw(I2C_PORT)->tar = addr;
+                i2c_get_hw(I2C_PORT)->enable = 1;
+                dma_addr = addr;
+            }
+            xfer_start = ring_head;
+            return 1;
+        }
+
+        case U8X8_MSG_BYTE_SEND:
+            while (arg_int > 0) {
+                ring_put(*(uint8_t *)arg_ptr);
+                arg_ptr = (uint8_t *)arg_ptr + 1;
+                arg_int--;
+            }
+            return 1;
+
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            if (ring_head != xfer_start) {
+                // last byte of a transfer issues STOP condition
+                dma_ring[(ring_head - 1) & (I2C_DMA_RING_WORDS - 1)] |= I2C_IC_DATA_CMD_STOP_BITS;
+                dma_commit(ring_head);
+            }
+            return 1;
+
+        case U8X8_MSG_BYTE_SET_DC: // Not used for I2C
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
 // GPIO setup function (not required for I2C but for displays needing reset)
 uint8_t u8x8_gpio_and_delay_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr) {
     switch (msg) {
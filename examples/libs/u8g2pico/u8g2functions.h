@@ -8,6 +8,13 @@
 uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_gpio_and_delay_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 
+// DMA driven I2C transport, transfers are sent in background and callback returns as soon as data is staged
+uint8_t u8x8_byte_hw_i2c_dma(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+// returns true if staged data is still being sent
+bool u8x8_byte_hw_i2c_dma_busy();
+// wait for all staged data to be sent
+void u8x8_byte_hw_i2c_dma_wait();
+
 
 
 #endif
\ No newline at end of file
@@ -22,8 +22,17 @@
 #include "muiplusplus.hpp"
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <vector>
 
+#if MUIPP_PROFILING
+#define MUIPP_PROF_SCOPE(kind, id) muipp::prof_scope _prof(_profiler, muipp::prof_kind_t::kind, id)
+#define MUIPP_PROF_CANCEL() _prof.cancel()
+#else
+#define MUIPP_PROF_SCOPE(kind, id)
+#define MUIPP_PROF_CANCEL()
+#endif
+
 /*
 void MuiPage::add(MuiItem_pt&& item){
   // remove exiting items with specified id if present
@@ -50,22 +59,35 @@ void MuiPlusPlus::add(MuiPage_pt&& page){
 */
 
 void MuiPage::removeItem(muiItemId item_id){
-  // if we attempt to erase current item, then iterator must be invalidated
-  if ( currentItem != items.end() && (*currentItem)->id == item_id ){
-    currentItem = items.end();
+  auto it = std::find_if(items.begin(), items.end(), muipp::MatchID<MuiItem*>(item_id));
+  if (it == items.end()) return;
+  size_t idx = std::distance(items.begin(), it);
+  // if we attempt to erase current item, then index must be invalidated
+  if ( currentItem == idx ){
+    currentItem = muipp::npos;
     itm_selected = false;
+  } else if ( currentItem != muipp::npos && currentItem > idx )
+    --currentItem;    // keep index pointing to the same item
+
+  items.erase(it);
+  focusable.erase(idx);
+}
+
+const muipp::bitmap& MuiPage::_focusable(){
+  if (focusable_gen != _flags_gen){
+    focusable.clear();
+    focusable.resize(items.size());
+    for (size_t i = 0; i != items.size(); ++i)
+      focusable.set(i, !items[i]->getHidden() && !items[i]->getConstant());
+    focusable_gen = _flags_gen;
   }
-  // Replace std::erase_if with remove_if + erase
-  items.erase(
-    std::remove_if(items.begin(), items.end(), muipp::MatchID<MuiItem_pt>(item_id)),
-    items.end()
-  );
+  return focusable;
 }
 
+// get screen area occupied by an item, items with unknown area are considered to take the whole screen
+static const muipp::rect_t& _item_area(const MuiItem& itm){ return itm.getBBox().empty() ? muipp::rect_fullscreen : itm.getBBox(); }
 
 MuiPlusPlus::MuiPlusPlus(){
-  // invalidate iterator
-  currentPage = pages.end();
 }
 /*
 MuiPlusPlus::~MuiPlusPlus(){
@@ -76,24 +98,131 @@ MuiPlusPlus::~MuiPlusPlus(){
   items.clear();
 }
 */
+
+void MuiPlusPlus::reserve(size_t items_num, size_t pages_num){
+  items.reserve(items_num);
+  _items_idx.reserve(items_num);
+  pages.reserve(pages_num);
+  _pages_idx.reserve(pages_num);
+  _labels_idx.reserve(pages_num);
+}
+
 muiItemId MuiPlusPlus::makePage(const char* name, muiItemId parent, item_opts options){
   ++_pages_index;
   // printf("makePage %u %s, parent %u\n", _pages_index, name, parent);
   pages.emplace_back(_pages_index, name, parent, options);
+  _pages_idx.emplace(_pages_index, pages.size() - 1);
+  if (name)
+    _index_label(name, pages.size() - 1);
   return _pages_index;
 }
 
+muiItemId MuiPlusPlus::makePage(const char* name, muiItemId parent, muipp::page_builder_t builder, item_opts options){
+  muiItemId id = makePage(name, parent, options);
+  pages.back().builder = builder;
+  return id;
+}
+
+void MuiPlusPlus::_build_page(size_t idx){
+  size_t first = items.size();
+  // builder could add pages and items reallocating containers, so keep a copy of it and access page by index
+  auto builder = pages[idx].builder;
+  builder(*this, pages[idx].id);
+
+  auto &page = pages[idx];
+  page.built = true;
+  page.lazy_items.clear();
+  for (size_t i = first; i < items.size(); ++i)
+    page.lazy_items.push_back(items[i]->id);
+  _lazy_items += page.lazy_items.size();
+}
+
+void MuiPlusPlus::_evict(MuiPage& page){
+  for (auto id : page.lazy_items)
+    removeItem(id);
+  _lazy_items -= std::min(_lazy_items, page.lazy_items.size());
+  page.lazy_items.clear();
+  // shared items linked by builder will be linked again on rebuild
+  page._clear();
+  page.built = false;
+}
+
+void MuiPlusPlus::_evict_pages(){
+  while (_lazy_items > _lazy_budget){
+    MuiPage* lru = nullptr;
+    for (auto &p : pages){
+      // page on screen can't be evicted until it's area has been cleared on refresh
+      if (p.lazy_items.empty() || &p == _page() || p.id == _rendered_page) continue;
+      if (!lru || p.visited < lru->visited)
+        lru = &p;
+    }
+    if (!lru) return;
+    _evict(*lru);
+  }
+}
+
+mui_err_t MuiPlusPlus::evictPage(muiItemId page_id){
+  auto p = _page_by_id(page_id);
+  if (!p || !p->builder || p == _page() || p->id == _rendered_page) return mui_err_t::id_err;
+  _evict(*p);
+  return mui_err_t::ok;
+}
+
+MuiPage* MuiPlusPlus::_page_by_label(const char* label){
+  if (!label) return nullptr;
+  auto i = _labels_idx.find(label);
+  return i == _labels_idx.end() ? nullptr : &pages[i->second.idx];
+}
+
+void MuiPlusPlus::_index_label(const char* label, size_t idx){
+  auto i = _labels_idx.find(label);
+  // label index keeps the first page with the same name
+  if (i != _labels_idx.end()){
+    if (i->second.idx > idx)
+      i->second.idx = idx;
+    return;
+  }
+  size_t len = std::strlen(label);
+  label_t l{ std::make_unique<char[]>(len + 1), idx };
+  std::memcpy(l.str.get(), label, len + 1);
+  std::string_view key(l.str.get(), len);
+  _labels_idx.emplace(key, std::move(l));
+}
+
+mui_err_t MuiPlusPlus::setPageName(muiItemId page_id, const char* name){
+  auto p = _page_by_id(page_id);
+  if (!p) return mui_err_t::id_err;
+  size_t idx = p - pages.data();
+  // look for the entry by index, not by page's name, the name buffer could have been rewritten already
+  auto i = std::find_if(_labels_idx.begin(), _labels_idx.end(), [idx](const auto& l){ return l.second.idx == idx; });
+  p->setName(name);
+  if (i != _labels_idx.end()){
+    // old label passes to the next page with the same name, if any
+    auto l = std::move(i->second.str);
+    _labels_idx.erase(i);
+    for (size_t n = idx + 1; n < pages.size(); ++n){
+      if (pages[n].name && !std::strcmp(pages[n].name, l.get())){
+        _index_label(pages[n].name, n);
+        break;
+      }
+    }
+  }
+  if (name)
+    _index_label(name, idx);
+  return mui_err_t::ok;
+}
+
 mui_err_t MuiPlusPlus::addMuippItem(MuiItem_pt item, muiItemId page_id){
   //Serial.printf("Adding item %u, page %u\n", item->id, page_id);
   muiItemId item_id(item->id);    // this must a copy!
-  auto i = std::find_if(items.cbegin(), items.cend(), muipp::MatchID<MuiItem_pt>(item_id));
-  if ( i != items.cend() ){
+  if ( _items_idx.count(item_id) ){
       // printf("item:%u already exist!\n", item->id);
     return mui_err_t::id_exist;
   }
 
   // move item to container
   items.emplace_back(std::move(item));
+  _items_idx.emplace(item_id, items.size() - 1);
   
   // link item with the specified page
   if (page_id){
@@ -109,56 +238,99 @@ mui_err_t MuiPlusPlus::addItemToPage(muiItemId item_id, muiItemId page_id){
 
   // check if such page exist
   auto p = _page_by_id(page_id);
-  if ( p == pages.end() ){
+  if ( !p ){
     // printf("page:%u not found\n", page_id);
     return mui_err_t::id_err;
   }
 
   auto i = _item_by_id(item_id);
-  if ( i == items.end() ){
+  if ( !i ){
     // printf("item:%u not found\n", item_id);
     return mui_err_t::id_err;
   }
 //
-  (*p).items.emplace_back((*i));
+  p->_add(i);
   // printf("bound item:%u to page:%u\n", item_id, page_id);
   return mui_err_t::ok;
 }
 
+mui_err_t MuiPlusPlus::addPages(const muipp::page_def_t* table, size_t num, muiItemId* ids){
+  if (!table) return mui_err_t::id_err;
+
+  size_t items_num{0};
+  for (size_t i = 0; i != num; ++i)
+    items_num += table[i].items_num;
+  reserve(items.size() + items_num, pages.size() + num);
+
+  // pages are created sequentially, so ids are known in advance
+  muiItemId first_id = _pages_index + 1;
+  for (size_t i = 0; i != num; ++i){
+    const auto &d = table[i];
+    muiItemId page_id = makePage(d.name, d.parent < num ? first_id + d.parent : 0, d.options);
+    if (ids) ids[i] = page_id;
+
+    for (size_t j = 0; j != d.items_num; ++j){
+      MuiItem* itm = d.items[j];
+      if (!itm) return mui_err_t::id_err;
+      // same item could be shared between pages, then it's only need to be bound
+      auto existing = _item_by_id(itm->id);
+      if (existing && existing != itm) return mui_err_t::id_exist;
+      mui_err_t err = existing ? addItemToPage(itm->id, page_id) : addMuippItem(*itm, page_id);
+      if (err != mui_err_t::ok) return err;
+    }
+
+    if (d.autoselect){
+      mui_err_t err = pageAutoSelect(page_id, d.autoselect);
+      if (err != mui_err_t::ok) return err;
+    }
+  }
+  return mui_err_t::ok;
+}
+
 void MuiPlusPlus::menuStart(muiItemId page, muiItemId item){
   // switch to page, if error, then select first page by default
-  if( goPageId(page, item) != mui_err_t::ok){
-    currentPage = pages.begin();
-    (*currentPage).itm_selected = false;
+  if( goPageId(page, item) != mui_err_t::ok && pages.size()){
+    currentPage = 0;
+    pages[currentPage].itm_selected = false;
   }
 }
 
 
 mui_err_t MuiPlusPlus::goPageId(muiItemId page_id, muiItemId item_id){
   // printf("goPageId:%u,%u\n", page_id, item_id);
-  auto p = _page_by_id(page_id);
-  // check if no such page or page has no any items at all?
-  if ( p == pages.end() || !(*p).items.size() ){
+  auto p = _pages_idx.find(page_id);
+  if ( p == _pages_idx.end() )
+    return mui_err_t::id_err;
+  size_t idx = p->second;
+  // lazy page is built on first visit
+  if ( pages[idx].builder && !pages[idx].built )
+    _build_page(idx);
+  // check if page has no any items at all?
+  if ( !pages[idx].items.size() ){
     return mui_err_t::id_err;
   }
 
   // unfocus/unselect and notify current item if it is defined
-  if ( (currentPage != pages.end()) && ((*currentPage).currentItem != (*currentPage).items.end()) && (*(*currentPage).currentItem)->focused ){
-    (*(*currentPage).currentItem)->focused = false;
-    (*(*currentPage).currentItem)->selected = false;
-    (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::unfocus));
+  if ( _item() && _item()->focused ){
+    _item()->focused = false;
+    _item()->selected = false;
+    _item()->requestRefresh();
+    _item()->muiEvent(mui_event(mui_event_t::unfocus));
   }
 
-  currentPage = p;
-  // invalidate current item iterator
-  (*currentPage).currentItem = (*currentPage).items.end();
+  currentPage = idx;
+  // invalidate current item index
+  _page()->currentItem = muipp::npos;
+  _page()->visited = ++_visits;
+  // free memory taken by pages visited long ago
+  _evict_pages();
 
   // try to focus and select specified item on a page
   if ( item_id && (goItmId(item_id) == mui_err_t::ok) ) return mui_err_t::ok;
   // else target item is not specified (==0) or not found
 
   // Let's check if autoselect item is defined for a page, then focus and select it
-  if ((*currentPage).autoSelect && (goItmId((*currentPage).autoSelect) == mui_err_t::ok) ){
+  if (_page()->autoSelect && (goItmId(_page()->autoSelect) == mui_err_t::ok) ){
     return mui_err_t::ok;
   }
 
@@ -171,92 +343,173 @@ mui_err_t MuiPlusPlus::goPageId(muiItemId page_id, muiItemId item_id){
 
 mui_err_t MuiPlusPlus::goPageLbl(const char* label){
   auto p = _page_by_label(label);
-  if ( p != pages.cend() ){
-    return goPageId((*p).id);
+  if ( p ){
+    return goPageId(p->id);
   }
   return mui_err_t::id_err;
 }
 
 mui_err_t MuiPlusPlus::goItmId(muiItemId item_id){
-  if (!item_id) return mui_err_t::id_err;
+  if (!item_id || !_page()) return mui_err_t::id_err;
   // if I need to switch to specific item on a page, let's check if it is registered there
-  auto it = std::find_if( (*currentPage).items.begin(), (*currentPage).items.end(), muipp::MatchID<MuiItem_pt>(item_id) );
-  if (it == (*currentPage).items.end()) return mui_err_t::id_err;
+  auto &page_items = _page()->items;
+  auto it = std::find_if( page_items.begin(), page_items.end(), muipp::MatchID<MuiItem*>(item_id) );
+  if (it == page_items.end()) return mui_err_t::id_err;
 
-  // OK, item is indeed found, we are happy, check if it is not static
-  if ( (*it)->getConstant() )
+  // OK, item is indeed found, we are happy, check if it is not static or hidden
+  if ( (*it)->getConstant() || (*it)->hidden )
     return mui_err_t::id_err;
 
   // unfocus and notify current item if it is defined and focused
-  if ( (currentPage != pages.end()) && ((*currentPage).currentItem != (*currentPage).items.end()) && (*(*currentPage).currentItem)->focused ){
-    (*(*currentPage).currentItem)->focused = false;
-    (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::unfocus));
+  if ( _item() && _item()->focused ){
+    _item()->focused = false;
+    _item()->requestRefresh();
+    _item()->muiEvent(mui_event(mui_event_t::unfocus));
   }
 
-  (*currentPage).currentItem = it;
+  _page()->currentItem = std::distance(page_items.begin(), it);
   // check if item is selectable, then focus on it and select it
   if ((*it)->getSelectable()){
-    (*currentPage).itm_selected = true;
-    (*(*currentPage).currentItem)->selected = true;
+    _page()->itm_selected = true;
+    (*it)->selected = true;
   }
   // update item's focus flag, we focus on it anyway, event if it' not selectable
   (*it)->focused = true;
+  (*it)->requestRefresh();
   // notify item that it received focus
   (*it)->muiEvent(mui_event(mui_event_t::focus));
   return mui_err_t::ok;
 }
 
 
-void MuiPlusPlus::render(void* r){
+void MuiPlusPlus::render(muipp::renderer_ref r){
   // won't run with no pages or items
-  if (!pages.size() || !items.size())
+  if (!_page() || !items.size())
     return;
 
-  //// printf("Render %u items on page:%u\n", (*currentPage).items.size(), (*currentPage).id);
+  MUIPP_PROF_SCOPE(frame, _page()->id);
+  //// printf("Render %u items on page:%u\n", _page()->items.size(), _page()->id);
 
-  // render each item on a page
-  for (auto itm : (*currentPage).items ){
+  // render each visible item on a page
+  for (auto itm : _page()->items ){
+    if (itm->hidden) continue;
     //// printf("Render item:%u\n", id);
     // render selected item passing it a reference to current page
-    (*itm).render(&(*currentPage), r);
-  }
+    _render_item(itm, r);
+  }
+  // full render invalidates all dirty regions, whole screen must be updated
+  _rendered_page = _page()->id;
+  _dirty.clear();
+  _hidden_areas.clear();
+  // previous page has left the screen and could be evicted now
+  _evict_pages();
+}
+
+void MuiPlusPlus::_render_item(MuiItem* itm, muipp::renderer_ref r){
+  MUIPP_PROF_SCOPE(render, itm->id);
+  bool cache = _cache && itm->cacheable();
+  if (cache && !itm->refresh_req() && _cache->restore(*itm, _page()->id))
+    return;
+
+  itm->render(_page(), r);
+  if (!cache) return;
+
+  // cached image of an item that overlaps others would contain their pixels
+  const auto &bbox = itm->getBBox();
+  bool overlaps = bbox.empty() || std::any_of(_page()->items.cbegin(), _page()->items.cend(),
+    [itm, &bbox](const MuiItem* i){ return i != itm && (i->getBBox().empty() || i->getBBox().intersects(bbox)); });
+  if (!overlaps)
+    _cache->save(*itm, _page()->id);
 }
 
-bool MuiPlusPlus::refresh(void* r){
-  bool rr{false};
+bool MuiPlusPlus::refresh(muipp::renderer_ref r){
+  _dirty.clear();
   // won't run with no pages or items
-  if (!pages.size() || !items.size())
-    return rr;
+  if (!_page() || !items.size())
+    return false;
+
+  MUIPP_PROF_SCOPE(frame, _page()->id);
+  //Serial.printf("Render %u items on page:%u\n", _page()->items.size(), _page()->id);
+
+  // page has been switched since last render, need to clear previous page's items and render all items of a new page
+  if (_rendered_page != _page()->id){
+    auto p = _page_by_id(_rendered_page);
+    if (p){
+      for (auto itm : p->items )
+        _dirty_add(_item_area(*itm));
+    }
+    if (_clear_cb){
+      for (const auto &rect : _dirty)
+        _clear_cb(rect);
+    }
+    for (auto itm : _page()->items ){
+      if (itm->hidden) continue;
+      _render_item(itm, r);
+      _dirty_add(_item_area(*itm));
+    }
+    _rendered_page = _page()->id;
+    _hidden_areas.clear();
+    // previous page has left the screen and could be evicted now
+    _evict_pages();
+    return true;
+  }
 
-  //Serial.printf("Render %u items on page:%u\n", (*currentPage).items.size(), (*currentPage).id);
+  // collect areas of the items that needs refresh and the items that have been hidden
+  for (const auto &rect : _hidden_areas)
+    _dirty_add(rect);
+  _hidden_areas.clear();
+  for (auto itm : _page()->items ){
+    if (!itm->hidden && itm->refresh_req())
+      _dirty_add(_item_area(*itm));
+  }
+
+  if (_dirty.empty()){
+    // nothing to draw, do not count idle polls as frames
+    MUIPP_PROF_CANCEL();
+    return false;
+  }
 
-  // render each item on a page if needed
-  for (auto itm : (*currentPage).items ){
-    bool item_refresh = (*itm).refresh_req();
+  // clear areas prior to rendering, otherwise overlapping items might be wiped out
+  if (_clear_cb){
+    for (const auto &rect : _dirty)
+      _clear_cb(rect);
+  }
+
+  // render each item on a page if it needs refresh or it's area has been cleared
+  for (auto itm : _page()->items ){
+    if (itm->hidden) continue;
+    bool item_refresh = itm->refresh_req();
+    if (!item_refresh && _clear_cb){
+      // items with unknown area must be redrawn anyway
+      item_refresh = itm->getBBox().empty() || std::any_of(_dirty.cbegin(), _dirty.cend(), [itm](const muipp::rect_t& rect){ return rect.intersects(itm->getBBox()); });
+    }
     if (item_refresh){
       // render selected item passing it a reference to current page
-      (*itm).render(&(*currentPage), r);
-      rr = true;
+      _render_item(itm, r);
+      // item's area might be changed after rendering
+      _dirty_add(_item_area(*itm));
     }
   }
-  return rr;
+  return true;
 }
 
 mui_event MuiPlusPlus::muiEvent(mui_event e){
   // printf("MPP event:%u\n", static_cast<uint32_t>(e.eid));
   _evt_recursion = 0;
-  if (e.eid == mui_event_t::noop) return e;
+  if (e.eid == mui_event_t::noop || !_page()) return e;
+
+  MUIPP_PROF_SCOPE(event, _item() ? _item()->id : 0);
 
   // if focused Item on current page exist and active - pass navigation and value events there and process reply event
-  if ( (*currentPage).currentItem != (*currentPage).items.end() ){
+  if ( _item() ){
     // if item is selected then it could receive cursor + value events, it's resone will be forwarded to _menu_navigation() call
-    if ((*currentPage).itm_selected && (static_cast<size_t>(e.eid) < 100 || static_cast<size_t>(e.eid) >= 200) ){
-      return _menu_navigation( (* (*currentPage).currentItem )->muiEvent(e) );
+    if (_page()->itm_selected && (static_cast<size_t>(e.eid) < 100 || static_cast<size_t>(e.eid) >= 200) ){
+      return _menu_navigation( _item()->muiEvent(e) );
     }
 
     // if item is not selectable, then it can still receive value and "enter" events without grabbing cursor navigation events, it's resone will be forwarded to _menu_navigation() call
-    if ((* (*currentPage).currentItem )->getSelectable() == false && (e.eid == mui_event_t::enter || static_cast<size_t>(e.eid) >= 200) ){
-      return _menu_navigation( (* (*currentPage).currentItem )->muiEvent(e) );
+    if (_item()->getSelectable() == false && (e.eid == mui_event_t::enter || static_cast<size_t>(e.eid) >= 200) ){
+      return _menu_navigation( _item()->muiEvent(e) );
     }
   }
 
@@ -268,9 +521,99 @@ mui_event MuiPlusPlus::muiEvent(mui_event e){
   return {};
 }
 
+// returns relative offset for cursor move events, 0 for any other events
+static int32_t _move_delta(mui_event_t eid){
+  switch (eid){
+    case mui_event_t::moveUp :
+    case mui_event_t::moveLeft :
+      return -1;
+    case mui_event_t::moveDown :
+    case mui_event_t::moveRight :
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+bool MuiPlusPlus::postEvent(mui_event e){
+  uint32_t in = _ovf_in.load(std::memory_order_relaxed);
+  // overflowed moves must be published with a marker before any other event is queued
+  if (in != _ovf_posted && _evt_queue.push(mui_event(mui_event_t::noop, static_cast<int32_t>(in), &_ovf_in)))
+    _ovf_posted = in;
+  if (in == _ovf_posted && _evt_queue.push(e)) return true;
+
+  int32_t delta = _move_delta(e.eid);
+  if (!delta) return false;
+  // queue is full, cursor move is added to the overflowed moves
+  _ovf_in.store(in + delta, std::memory_order_release);
+  return true;
+}
+
+mui_event MuiPlusPlus::processEvents(){
+  for (;;){
+    mui_event e;
+    int32_t delta;
+    // overflowed moves sum must be loaded before the queue is checked, if queue is empty
+    // then no events have been posted after those moves and moves could be taken right away
+    uint32_t in = _ovf_in.load(std::memory_order_acquire);
+    const mui_event* q = _evt_queue.front();
+    if (!q){
+      _ovf_pending += static_cast<int32_t>(in - _ovf_out);
+      _ovf_out = in;
+    } else if (_ovf_marker(*q)){
+      // moves published with a marker follow the events queued before it
+      _ovf_pending += static_cast<int32_t>(static_cast<uint32_t>(q->param) - _ovf_out);
+      _ovf_out = static_cast<uint32_t>(q->param);
+      _evt_queue.pop();
+      continue;
+    }
+
+    if (_ovf_pending){
+      delta = _ovf_pending;
+      _ovf_pending = 0;
+      e = mui_event(delta < 0 ? mui_event_t::moveUp : mui_event_t::moveDown);
+    } else if (q){
+      e = *q;
+      _evt_queue.pop();
+      delta = _move_delta(e.eid);
+    } else
+      break;
+
+    // collapse a run of cursor moves into a single step event if selected item can handle it
+    if (delta && _page() && _page()->itm_selected && _item() && _item()->acceptsStep()){
+      while ( (q = _evt_queue.front()) ){
+        if (_ovf_marker(*q)){
+          delta += static_cast<int32_t>(static_cast<uint32_t>(q->param) - _ovf_out);
+          _ovf_out = static_cast<uint32_t>(q->param);
+        } else if (_move_delta(q->eid))
+          delta += _move_delta(q->eid);
+        else
+          break;
+        _evt_queue.pop();
+      }
+      // moves in opposite directions cancel each other
+      if (!delta) continue;
+      e = mui_event(mui_event_t::step, delta);
+      delta = 1;
+    }
+
+    // overflowed moves that could not be collapsed are processed one by one
+    for (int32_t n = delta < 0 ? -delta : std::max<int32_t>(delta, 1); n; --n){
+      mui_event reply = muiEvent(e);
+      if (reply.eid != mui_event_t::noop){
+        // remaining moves are kept to be processed on next call, like events left in queue
+        if (--n)
+          _ovf_pending = delta < 0 ? -n : n;
+        return reply;
+      }
+    }
+  }
+  return {};
+}
+
 mui_event MuiPlusPlus::_menu_navigation(mui_event e){
   // do not work on empty pages (for now), check recursion level
-  if ( (*currentPage).items.size() == 0 || (++_evt_recursion > MAX_NESTED_EVENTS) ) return {};
+  if ( !_page() || _page()->items.size() == 0 || (++_evt_recursion > MAX_NESTED_EVENTS) ) return {};
   // printf("_menu_navigation evt:%u, recursion:%u\n", static_cast<uint32_t>(e.eid), _evt_recursion);
 
   switch(e.eid){
@@ -291,13 +634,14 @@ mui_event MuiPlusPlus::_menu_navigation(mui_event e){
     // enter/action event
     case mui_event_t::enter :
       // if focused item is selectable, mark it as 'selected', it will start stealing cursor events from menu navigator untill released
-      if ( currentPage == pages.end() || (*currentPage).currentItem == (*currentPage).items.end() || !(*(*currentPage).currentItem) ) break;    // if any of iterators are invalidated
-      if ((*(*currentPage).currentItem)->getSelectable()){
-        (*currentPage).itm_selected = true;
-        (*(*currentPage).currentItem)->selected = true;
+      if ( !_item() ) break;    // if any of indexes are invalidated
+      if (_item()->getSelectable()){
+        _page()->itm_selected = true;
+        _item()->selected = true;
+        _item()->requestRefresh();
         // send "select" event to the item
         // maybe I need recursive call to self here?
-        _menu_navigation( (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::select)) );
+        _menu_navigation( _item()->muiEvent(mui_event(mui_event_t::select)) );
       }
       break;
 
@@ -318,6 +662,19 @@ mui_event MuiPlusPlus::_menu_navigation(mui_event e){
     case mui_event_t::escape :
       return _evt_escape();
 
+    // item visibility, event param is item id
+    case mui_event_t::hideItem :
+      hideItem( static_cast<muiItemId>(e.param) );
+      break;
+
+    case mui_event_t::unhideItem :
+      unhideItem( static_cast<muiItemId>(e.param) );
+      break;
+
+    case mui_event_t::hideToggle :
+      hideToggle( static_cast<muiItemId>(e.param) );
+      break;
+
     case mui_event_t::quitMenu :
       return mui_event(mui_event_t::quitMenu);
 
@@ -342,8 +699,8 @@ void MuiPlusPlus::_feedback_event(mui_event e){
 
 mui_event MuiPlusPlus::_prev_page(){
   // check if current page has any parent page 
-  if ( (*currentPage).parent_page ){
-    goPageId((*currentPage).parent_page);
+  if ( _page() && _page()->parent_page ){
+    goPageId(_page()->parent_page);
     return {};
   }
 
@@ -354,14 +711,14 @@ mui_event MuiPlusPlus::_prev_page(){
 mui_err_t MuiPlusPlus::pageAutoSelect(muiItemId page_id, muiItemId item_id){
   // printf("pageAutoSelect:%u,%u\n", page_id, item_id);
   auto p = _page_by_id(page_id);
-  if ( p == pages.cend() ){
+  if ( !p ){
     return mui_err_t::id_err;
   }
 
-  auto it = std::find_if( (*p).items.begin(), (*p).items.end(), muipp::MatchID<MuiItem_pt>(item_id) );
-  if (it != (*p).items.end()){
+  auto it = std::find_if( p->items.begin(), p->items.end(), muipp::MatchID<MuiItem*>(item_id) );
+  if (it != p->items.end()){
     // OK, item is indeed found, we are happy
-    (*p).autoSelect = item_id;
+    p->autoSelect = item_id;
     return mui_err_t::ok;
   }
 
@@ -369,17 +726,18 @@ mui_err_t MuiPlusPlus::pageAutoSelect(muiItemId page_id, muiItemId item_id){
 }
 
 mui_event MuiPlusPlus::_evt_escape(){
-  if (currentPage == pages.end()){
+  if (!_page()){
     // I'm in some undeterminated state where curent page does not exist, signal to quit the menu
     return mui_event(mui_event_t::quitMenu);
   }
 
   // first unselect current item if it's selected and let menu navigation work on moving focus on other items
-  if ((*currentPage).itm_selected){
-    (*currentPage).itm_selected = false;
-    (*(*currentPage).currentItem)->selected = false;
+  if (_page()->itm_selected && _item()){
+    _page()->itm_selected = false;
+    _item()->selected = false;
+    _item()->requestRefresh();
     // notify item that it lost selection
-    (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::unselect));
+    _item()->muiEvent(mui_event(mui_event_t::unselect));
     return {};
   }
 
@@ -391,97 +749,84 @@ mui_event MuiPlusPlus::_evt_escape(){
 uint32_t MuiPlusPlus::nextIndex(){
   do {
     ++_items_index;
-  } while(_item_by_id(_items_index) != items.end());
+  } while(_items_idx.count(_items_index));
 
   return _items_index;
 }
 
 mui_err_t MuiPlusPlus::_evt_nextItm(){
   // printf("_evt_nextItm\n");
-  if ( !(*currentPage).items.size() || (*currentPage).currentItem == (*currentPage).items.end() ){
-    // invalid iterator, nothing on page we can work on
+  if ( !_item() ){
+    // invalid index, nothing on page we can work on
     // printf("no valid items on a page!\n");
     return mui_err_t::id_err;
   }
 
-  if (!(*(*currentPage).currentItem)->getConstant()){
-    (*(*currentPage).currentItem)->focused = false;
+  MuiPage &page = *_page();
+  if (!_item()->getConstant()){
+    _item()->focused = false;
+    _item()->requestRefresh();
     // notify current item that it has lost focus
-    (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::unfocus));
+    _item()->muiEvent(mui_event(mui_event_t::unfocus));
   }
-  // move focus on next item
-  while ( ++(*currentPage).currentItem != (*currentPage).items.end() ){
-    // stop on first non-const item
-    if ( !(*(*currentPage).currentItem)->getConstant() ) break;
-  }
-
-//  do{
-//    ++(*currentPage).currentItem;
-//  } while( ((*currentPage).currentItem != (*currentPage).items.end()) || (*(*currentPage).currentItem)->getConstant() );
+  // move focus on next focusable item
+  page.currentItem = page._focusable().find_next(page.currentItem + 1);
 
-  if ((*currentPage).currentItem == (*currentPage).items.end())
+  // check if tail of the page is reached and no focusable item found, then cycle to the first one
+  if (page.currentItem == muipp::npos)
     return _any_focusable_item_on_a_page_b();
   else {
     // update focus flag
-    (*(*currentPage).currentItem)->focused = true;
+    _item()->focused = true;
+    _item()->requestRefresh();
     // notify item that it received focus
-    _menu_navigation( (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::focus)) );
+    _menu_navigation( _item()->muiEvent(mui_event(mui_event_t::focus)) );
   }
   return mui_err_t::ok;
 }
 
 mui_err_t MuiPlusPlus::_evt_prevItm(){
   // printf("_evt_prevItm\n");
-  if ( !(*currentPage).items.size() || (*currentPage).currentItem == (*currentPage).items.end() ){
-    // invalid iterator, nothing on page we can work on
+  if ( !_item() ){
+    // invalid index, nothing on page we can work on
     // printf("no valid items on a page!\n");
     return mui_err_t::id_err;
   }
 
-  if (!(*(*currentPage).currentItem)->getConstant()){
-    (*(*currentPage).currentItem)->focused = false;
+  MuiPage &page = *_page();
+  if (!_item()->getConstant()){
+    _item()->focused = false;
+    _item()->requestRefresh();
     // notify current item that it has lost focus
-    (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::unfocus));
-  }
-  // move focus on prev item (if we are at first item, cycle to the last)
-  if ((*currentPage).currentItem == (*currentPage).items.begin())
-    (*currentPage).currentItem = std::prev( (*currentPage).items.end() );
-
-  while ( --(*currentPage).currentItem != (*currentPage).items.begin()){
-    // printf("p1\n");
-    // stop on first non-const item
-    if ( !(*(*currentPage).currentItem)->getConstant() ) break;
+    _item()->muiEvent(mui_event(mui_event_t::unfocus));
   }
+  // move focus on prev focusable item, index becomes npos when passing the head of the page
+  page.currentItem = page.currentItem ? page._focusable().find_prev(page.currentItem - 1) : muipp::npos;
 
-//  do {
-//    // printf("p1\n");
-//    --(*currentPage).currentItem;
-//  } while( (*currentPage).currentItem != (*currentPage).items.begin() || (*(*currentPage).currentItem)->getConstant() );
-    // printf("p2\n");
-
-  // check if last iterator is reached head of list and still we have constant element that we can't focus on
-  if ((*currentPage).currentItem == (*currentPage).items.begin() && (*(*currentPage).currentItem)->getConstant())
+  // check if head of the page is reached and still no focusable item found, then cycle to the last one
+  if (page.currentItem == muipp::npos)
     return _any_focusable_item_on_a_page_e();
   else {
-    // printf("p4\n");
     // update focus flag
-    (*(*currentPage).currentItem)->focused = true;
+    _item()->focused = true;
+    _item()->requestRefresh();
     // notify item that it received focus
-    _menu_navigation( (*(*currentPage).currentItem)->muiEvent(mui_event(mui_event_t::focus)) );
+    _menu_navigation( _item()->muiEvent(mui_event(mui_event_t::focus)) );
   }
   return mui_err_t::ok;
 }
 
 mui_err_t MuiPlusPlus::_any_focusable_item_on_a_page_b(){
   // printf("_any_focusable_item_on_a_page_b\n");
-  for (auto it = (*currentPage).items.begin(); it != (*currentPage).items.end(); ++it){
-    if ( (*it)->getConstant() )
-      continue;
-    (*currentPage).currentItem = it;
+  MuiPage &page = *_page();
+  size_t i = page._focusable().find_next(0);
+  if (i != muipp::npos){
+    page.currentItem = i;
     // update new item's focus flag
-    (*it)->focused = true;
+    page.items[i]->focused = true;
+    page.items[i]->requestRefresh();
     // notify item that it received focus
-    (*it)->muiEvent(mui_event(mui_event_t::focus));
+    page.items[i]->muiEvent(mui_event(mui_event_t::focus));
     return mui_err_t::ok;
   }
 
@@ -490,39 +835,113 @@ mui_err_t MuiPlusPlus::_any_focusable_item_on_a_page_b(){
 
 mui_err_t MuiPlusPlus::_any_focusable_item_on_a_page_e(){
   // printf("_any_focusable_item_on_a_page_e\n");
-  if ( !(*currentPage).items.size())   return mui_err_t::id_err;
-  for (auto it = std::prev( (*currentPage).items.end() ); it != (*currentPage).items.begin(); --it){
-    if ( (*it)->getConstant() )
-      continue;
-    (*currentPage).currentItem = it;
+  MuiPage &page = *_page();
+  size_t i = page._focusable().find_prev(muipp::npos);
+  if (i != muipp::npos){
+    page.currentItem = i;
     // update new item's focus flag
-    (*it)->focused = true;
+    page.items[i]->focused = true;
+    page.items[i]->requestRefresh();
     // notify item that it received focus
-    (*it)->muiEvent(mui_event(mui_event_t::focus));
+    page.items[i]->muiEvent(mui_event(mui_event_t::focus));
     return mui_err_t::ok;
   }
 
-  // invalidate iterator
-  (*currentPage).currentItem = (*currentPage).items.end();
+  // invalidate index
+  page.currentItem = muipp::npos;
   return mui_err_t::id_err;
 }
 
+mui_err_t MuiPlusPlus::hideItem(muiItemId item_id, bool hide){
+  auto itm = _item_by_id(item_id);
+  if (!itm) return mui_err_t::id_err;
+  if (itm->hidden == hide) return mui_err_t::ok;
+
+  itm->hidden = hide;
+  // focusable items bitmaps of the pages will be rebuilt on next navigation
+  ++MuiItem::_flags_gen;
+  if (!hide){
+    itm->requestRefresh();
+    // page might have been left without focus when all of it's items were hidden
+    if (_page() && !_item())
+      _any_focusable_item_on_a_page_b();
+    return mui_err_t::ok;
+  }
+
+  // item's area must be cleared and items that overlap it redrawn, only if it's on the screen now,
+  // bbox of an item from other page is stale
+  auto p = _page_by_id(_rendered_page);
+  if (p && !itm->getBBox().empty() && std::find(p->items.cbegin(), p->items.cend(), itm) != p->items.cend())
+    _hidden_areas.push_back(itm->getBBox());
+  // hidden item can't keep focus
+  if (_item() == itm){
+    if (_page()->itm_selected){
+      _page()->itm_selected = false;
+      itm->selected = false;
+      itm->muiEvent(mui_event(mui_event_t::unselect));
+    }
+    _evt_nextItm();
+  }
+  return mui_err_t::ok;
+}
+
+mui_err_t MuiPlusPlus::hideToggle(muiItemId item_id){
+  auto itm = _item_by_id(item_id);
+  if (!itm) return mui_err_t::id_err;
+  return hideItem(item_id, !itm->hidden);
+}
+
 void MuiPlusPlus::clear(){
+  _labels_idx.clear();
+  _pages_idx.clear();
+  _items_idx.clear();
   pages.clear();
   items.clear();
+  // all items are destroyed, arena memory could be released
+  _arena.release();
+  if (_cache)
+    _cache->clear();
   _items_index = _pages_index = 0;
-  currentPage = pages.end();
+  currentPage = muipp::npos;
+  _evt_queue.clear();
+  // moves overflowed before clearing are dropped
+  _ovf_out = _ovf_in.load(std::memory_order_acquire);
+  _ovf_pending = 0;
+  _lazy_items = 0;
+  _visits = 0;
+  _hidden_areas.clear();
 }
 
 void MuiPlusPlus::removeItem(muiItemId item_id){
+  auto i = _items_idx.find(item_id);
+  if (i == _items_idx.end()) return;
   // remove item from all the pages
-  for (auto &i : pages){
-    i.removeItem(item_id);
-  }
-  // erase the item itself
-  // Replace std::erase_if with remove_if + erase
-  items.erase(
-    std::remove_if(items.begin(), items.end(), muipp::MatchID<MuiItem_pt>(item_id)),
-    items.end()
-  );
+  for (auto &p : pages){
+    p.removeItem(item_id);
+  }
+  if (_cache)
+    _cache->drop(item_id);
+  // erase the item itself, the last item in container takes it's place so that other indexes stay valid
+  size_t idx = i->second;
+  _items_idx.erase(i);
+  if (idx != items.size() - 1){
+    items[idx] = std::move(items.back());
+    _items_idx[items[idx]->id] = idx;
+  }
+  items.pop_back();
+}
+
+void muipp::event_log_write(std::FILE* f, uint32_t ms, const mui_event& e){
+  std::fprintf(f, "%lu %u %ld\n", static_cast<unsigned long>(ms), static_cast<unsigned>(e.eid), static_cast<long>(e.param));
+}
+
+mui_err_t muipp::event_log_parse(const char* line, uint32_t& ms, mui_event& e){
+  unsigned long t;
+  unsigned eid;
+  long param{0};
+  if (std::sscanf(line, "%lu %u %ld", &t, &eid, &param) < 2 || eid >= static_cast<unsigned>(mui_event_t::_noop))
+    return mui_err_t::error;
+  ms = t;
+  e = mui_event(static_cast<mui_event_t>(eid), param);
+  return mui_err_t::ok;
 }
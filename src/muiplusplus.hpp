@@ -21,9 +21,10 @@
 
 #pragma once
 
-#include <list>
 #include <memory>
 #include <vector>
+#include <unordered_map>
+#include <string_view>
 #include "muipp_tpl.hpp"
 #include <cstdio>
 #include <functional>
@@ -31,6 +32,11 @@
 
 #define MAX_NESTED_EVENTS 5
 
+// capacity of MuiPlusPlus event queue, must be a power of 2
+#ifndef MUIPP_EVENT_QUEUE_SIZE
+#define MUIPP_EVENT_QUEUE_SIZE 16
+#endif
+
 enum class mui_err_t {
   ok = 0,
   error,            // generic error
@@ -72,6 +78,8 @@ enum class mui_event_t : size_t {
   // value change
   value =  200,     // any absolute value (i.e. encoder conter, etc...)
   step,             // relative value, +- offset from current
+  pageUp,           // move back by a page, i.e. a number of visible rows in a list
+  pageDown,         // move forward by a page
   blob,             // supplied blob object via (void*), mui_event::param could define blob size or coded type...
   string,           // supplied const char* via (void*), mui_event::param could define string len etc...
   custom1,          // placeholders
@@ -117,6 +125,10 @@ using mui_event_cb = std::function<mui_event (mui_event e)>;
  * 
  */
 class MuiItem {
+  friend class MuiPlusPlus;
+  // hidden item is not rendered and can't be focused, set by MuiPlusPlus::hideItem()
+  bool hidden{false};
+
 protected:
   // mnemonic name for the item
   const char* name;
@@ -130,6 +142,21 @@ protected:
    */
   bool refresh{false};
 
+  /**
+   * @brief counter of changes to items constant and hidden flags
+   * pages rebuild bitmaps of their focusable items when it changes,
+   * derived classes that change the value returned by getConstant() must increment it
+   */
+  static inline uint32_t _flags_gen{1};
+
+  /**
+   * @brief item's bounding box
+   * should be updated by derived classes on each render() call with the screen area that item has drawn on,
+   * it is used by MuiPlusPlus to track dirty regions on partial refreshes.
+   * Empty box means that item's area is unknown
+   */
+  muipp::rect_t bbox;
+
 public:
   // numeric identificator of item
   const muiItemId  id;
@@ -173,7 +200,23 @@ public:
 
   virtual bool getConstant() const { return opt.constant; }
 
-  virtual void setConstant(bool value) { opt.constant = value; }
+  virtual void setConstant(bool value) { opt.constant = value; ++_flags_gen; }
+
+  /**
+   * @brief returns true if Item can handle mui_event_t::step events
+   * if so, MuiPlusPlus::processEvents() would collapse a run of queued cursor moves
+   * into a single step event with a relative offset for the selected item
+   */
+  virtual bool acceptsStep() const { return false; }
+
+  /**
+   * @brief returns true if Item always renders the same image unless it requests a refresh
+   * image of such item could be cached and restored instead of rendering (see MuiRenderCache)
+   */
+  virtual bool cacheable() const { return false; }
+
+  // returns true if item is hidden
+  bool getHidden() const { return hidden; }
 
   //void setEventCallBack(mui_event_cb c){ cb = c; };
 
@@ -189,9 +232,9 @@ public:
    * @brief render item
    * 
    * @param parent - a pointer to the item's parent object
-   * @param r - rendering engine to use, if any
+   * @param r - rendering engine to use, if any, items that need it get it with r.get<Backend>()
    */
-  virtual void render(const MuiItem* parent, void* r = nullptr){ refresh = false; };
+  virtual void render(const MuiItem* parent, muipp::renderer_ref r = {}){ refresh = false; };
 
   /**
    * @brief Item refresh request
@@ -202,6 +245,18 @@ public:
    * @return false - if nothing to refresh
    */
   virtual bool refresh_req() const { return refresh; }
+
+  /**
+   * @brief request item to refresh on next MuiPlusPlus::refresh() call
+   * could be used when item's state has been changed externally
+   */
+  void requestRefresh(){ refresh = true; }
+
+  /**
+   * @brief get item's bounding box
+   * returns the screen area that item has drawn on during last render() call
+   */
+  const muipp::rect_t& getBBox() const { return bbox; }
 };
 
 class MuiItem_Uncontrollable : public MuiItem {
@@ -219,6 +274,83 @@ public:
 // Item pointer type declaration
 using MuiItem_pt = std::shared_ptr<MuiItem>;
 
+class MuiPlusPlus;
+
+namespace muipp {
+
+/**
+ * @brief wrap statically allocated item into item pointer without taking ownership
+ * no control block is allocated for such pointer, item object MUST outlive MuiPlusPlus container
+ * 
+ * @param item statically allocated item
+ * @return MuiItem_pt 
+ */
+inline MuiItem_pt static_item(MuiItem& item){ return MuiItem_pt(MuiItem_pt(), &item); }
+
+/**
+ * @brief static page descriptor
+ * a table of such descriptors along with arrays of pointers to statically allocated items
+ * could be placed in flash and loaded with MuiPlusPlus::addPages()
+ * 
+ */
+struct page_def_t {
+  // page label, pointer MUST persist while page exists
+  const char* name;
+  // array of pointers to statically allocated items on a page
+  MuiItem* const* items;
+  // number of items in array
+  size_t items_num;
+  // index of parent page in the same table, npos for a root page
+  size_t parent;
+  // id of an autoselect item on a page, 0 if none
+  muiItemId autoselect;
+  item_opts options;
+};
+
+/**
+ * @brief make static page descriptor from an array of item pointers
+ * 
+ * @param name page label
+ * @param items array of pointers to statically allocated items
+ * @param parent index of parent page in descriptors table, npos for a root page
+ * @param autoselect id of an autoselect item on a page, 0 if none
+ * @return constexpr page_def_t 
+ */
+template <size_t N>
+constexpr page_def_t page_def(const char* name, MuiItem* const (&items)[N], size_t parent = npos, muiItemId autoselect = 0, item_opts options = item_opts()){
+  return { name, items, N, parent, autoselect, options };
+}
+
+/**
+ * @brief callback function that creates items for a lazily built page
+ * it is called on first visit to the page and after the page has been evicted,
+ * items should be created and bound to the page with MuiPlusPlus::addMuippItem()
+ */
+using page_builder_t = delegate< void (MuiPlusPlus& menu, muiItemId page_id), 4 * sizeof(void*)>;
+
+/**
+ * @brief write event to a log as a text line "<time ms> <event id> <param>"
+ * could be used to record user sessions on a device and replay them on a host,
+ * event's (void*) arg is not recorded
+ * 
+ * @param f stream to write to, i.e. stdout or a file
+ * @param ms event time, i.e. clock_ms()
+ * @param e event
+ */
+void event_log_write(std::FILE* f, uint32_t ms, const mui_event& e);
+
+/**
+ * @brief parse a line of events log written with event_log_write()
+ * 
+ * @param line text line
+ * @param ms event time
+ * @param e parsed event
+ * @return mui_err_t error if line is malformed or event id is unknown
+ */
+mui_err_t event_log_parse(const char* line, uint32_t& ms, mui_event& e);
+
+} // end of namespace muipp
+
 
 /**
  * @brief MuiPage is just a containter MuiItem with refs to other MuiItem objects
@@ -226,16 +358,42 @@ using MuiItem_pt = std::shared_ptr<MuiItem>;
  */
 class MuiPage : public MuiItem {
   friend class MuiPlusPlus;
-  std::list<MuiItem_pt> items;
-  std::list<MuiItem_pt>::iterator currentItem;
+  // items on a page, items are owned by MuiPlusPlus container
+  std::vector<MuiItem*> items;
+  // index of the focused item on a page, any value out of items range means no item is focused
+  size_t currentItem{muipp::npos};
+  // bit per item in 'items', set for items that could be focused (non-constant and not hidden)
+  muipp::bitmap focusable;
+  // value of MuiItem::_flags_gen 'focusable' bitmap is valid for
+  uint32_t focusable_gen{0};
   // if itm_selected is true, than focused item will receive events from a cursor
   bool itm_selected{false};
   // parent page id (zero -> no parent page)
   muiItemId parent_page;
+  // builder that creates page's items on first visit, only for lazy pages
+  muipp::page_builder_t builder;
+  // ids of the items created by builder, those are destroyed when page is evicted
+  std::vector<muiItemId> lazy_items;
+  // lazy page has been built
+  bool built{false};
+  // sequence number of the last visit to the page, used to find least recently used pages
+  uint32_t visited{0};
+
+  // returns pointer to the focused item on a page or nullptr if none
+  MuiItem* _current() const { return currentItem < items.size() ? items[currentItem] : nullptr; }
+
+  // link item to the page
+  void _add(MuiItem* item){ items.push_back(item); focusable.push_back(!item->getHidden() && !item->getConstant()); }
+
+  // unlink all items from the page
+  void _clear(){ items.clear(); focusable.clear(); currentItem = muipp::npos; itm_selected = false; }
+
+  // bitmap of focusable items, rebuilt if any item's constant or hidden flag has been changed
+  const muipp::bitmap& _focusable();
   
 public:
   MuiPage(muiItemId id, const char* name = nullptr, muiItemId parent = 0, item_opts options = item_opts())
-    : MuiItem(id, name, options), parent_page(parent) { currentItem = items.end(); };
+    : MuiItem(id, name, options), parent_page(parent) {};
 
   /**
    * @brief specifies if there is an item on a page that will
@@ -257,6 +415,42 @@ public:
 };
 
 
+/**
+ * @brief interface for a cache of rendered items images
+ * MuiPlusPlus saves image of a cacheable item after rendering and restores it next time
+ * the item has to be drawn but has not requested a refresh, i.e. on revisiting a page or when item's area has been cleared.
+ * Only items that do not overlap other items on a page are cached.
+ * Implementation is backend specific, i.e. muipp::u8g2_render_cache keeps parts of U8g2's frame buffer
+ */
+class MuiRenderCache {
+public:
+  virtual ~MuiRenderCache(){};
+
+  /**
+   * @brief restore image of an item rendered on a page
+   * 
+   * @param item item object, image area is item's bounding box
+   * @param page_id page where item is rendered
+   * @return true if image has been restored
+   * @return false if image is not in cache, item must be rendered
+   */
+  virtual bool restore(const MuiItem& item, muiItemId page_id) = 0;
+
+  /**
+   * @brief save image of an item that has just been rendered on a page
+   * 
+   * @param item item object, image area is item's bounding box
+   * @param page_id page where item is rendered
+   */
+  virtual void save(const MuiItem& item, muiItemId page_id) = 0;
+
+  // drop cached images of an item for all pages
+  virtual void drop(muiItemId item_id) = 0;
+
+  // drop all cached images
+  virtual void clear() = 0;
+};
+
 
 /**
  * @brief MuiPlusPlus container onject
@@ -271,36 +465,108 @@ class MuiPlusPlus {
   muiItemId _pages_index{0};
 
 //protected:
-  std::list<MuiItem_pt> items;
-  std::list<MuiPage> pages;
-  std::list<MuiPage>::iterator currentPage;
+  // memory arena for items created with makeItem(), it must outlive items container
+  muipp::arena _arena;
+
+  // items and pages are kept in contiguous arrays, items and pages are referenced by index in the array
+  std::vector<MuiItem_pt> items;
+  std::vector<MuiPage> pages;
+  // index of the current page, any value out of pages range means no page is active
+  size_t currentPage{muipp::npos};
+
+  // lookup indexes from item/page id and page label to position in containers, must be kept in sync with containers
+  std::unordered_map<muiItemId, size_t> _items_idx;
+  std::unordered_map<muiItemId, size_t> _pages_idx;
+  // page label index entry, label is copied, so that index does not depend on the storage of page's name
+  struct label_t {
+    std::unique_ptr<char[]> str;
+    size_t idx;
+  };
+  // keys are views to the label copies kept in entries, so lookup by const char* does not allocate
+  std::unordered_map<std::string_view, label_t> _labels_idx;
 
   // event callback level
   unsigned _evt_recursion{0};
 
+  // queue for the events posted from ISRs or another core
+  muipp::spsc_queue<mui_event, MUIPP_EVENT_QUEUE_SIZE> _evt_queue;
+  // sum of cursor moves that did not fit into a full queue, it is written by producer only, so no atomic
+  // read-modify-write is needed. Sum is published with a marker event in the next free queue slot,
+  // so that overflowed moves are processed in order with other events
+  std::atomic<uint32_t> _ovf_in{0};
+  // producer side: value of _ovf_in published with the last marker event
+  uint32_t _ovf_posted{0};
+  // consumer side: value of _ovf_in that moves have been taken up to
+  uint32_t _ovf_out{0};
+  // consumer side: moves taken from _ovf_in but not processed yet
+  int32_t _ovf_pending{0};
+
+  // returns true if queued event is an overflowed moves marker
+  bool _ovf_marker(const mui_event& e) const { return e.eid == mui_event_t::noop && e.arg == &_ovf_in; }
+
+  // id of the page that was rendered last time
+  muiItemId _rendered_page{0};
+
+  // list of screen areas updated on last refresh() call
+  muipp::region_list_t _dirty;
+
+  // display area, dirty regions are clipped to it
+  muipp::rect_t _screen{muipp::rect_fullscreen};
+
+  // screen areas of the items hidden since last refresh, to be cleared
+  muipp::region_list_t _hidden_areas;
+
+  // callback to clear screen areas on partial refreshes
+  muipp::rect_cb_t _clear_cb;
+
+  // cache for images of static items
+  MuiRenderCache* _cache{nullptr};
+
+#if MUIPP_PROFILING
+  // render and event timing statistics
+  muipp::profiler _profiler;
+#endif
+
+  // number of items created by lazy pages builders and max number of such items to keep
+  size_t _lazy_items{0};
+  size_t _lazy_budget{SIZE_MAX};
+  // page visits counter
+  uint32_t _visits{0};
+
   /**
    * @brief find page by it's id
    * 
    * @param id 
-   * @return std::list<MuiPage>::iterator 
+   * @return MuiPage* pointer to page or nullptr if not found
    */
-  std::list<MuiPage>::iterator _page_by_id(muiItemId id){ return std::find_if(pages.begin(), pages.end(), muipp::MatchPageID<MuiPage>(id)); }
+  MuiPage* _page_by_id(muiItemId id){ auto i = _pages_idx.find(id); return i == _pages_idx.end() ? nullptr : &pages[i->second]; }
 
   /**
-   * @brief find item byt it's id
+   * @brief find page by it's label
+   * if there are several pages with same label, then the first one created is returned.
+   * Pages must be renamed with setPageName() to keep the index in sync
    * 
-   * @param id 
-   * @return std::list<MuiPage>::iterator 
+   * @param label 
+   * @return MuiPage* pointer to page or nullptr if not found
    */
-  std::list<MuiPage>::iterator _page_by_label(const char* label){ return std::find_if(pages.begin(), pages.end(), muipp::MatchLabel<MuiPage>(label)); }
+  MuiPage* _page_by_label(const char* label);
+
+  // add page at index idx to the labels index, first page with the same label is kept
+  void _index_label(const char* label, size_t idx);
 
   /**
    * @brief find item by it's id
    * 
    * @param id 
-   * @return std::list<MuiItem_pt>::iterator 
+   * @return MuiItem* pointer to item or nullptr if not found
    */
-  std::list<MuiItem_pt>::iterator _item_by_id(muiItemId id){ return std::find_if(items.begin(), items.end(), muipp::MatchID<MuiItem_pt>(id)); }
+  MuiItem* _item_by_id(muiItemId id){ auto i = _items_idx.find(id); return i == _items_idx.end() ? nullptr : items[i->second].get(); }
+
+  // returns pointer to the current page or nullptr if no page is active
+  MuiPage* _page(){ return currentPage < pages.size() ? &pages[currentPage] : nullptr; }
+
+  // returns pointer to the focused item on the current page or nullptr if none
+  MuiItem* _item(){ return currentPage < pages.size() ? pages[currentPage]._current() : nullptr; }
 
 
   /**
@@ -329,6 +595,16 @@ public:
    */
   void menuStart(muiItemId page, muiItemId item = 0);
 
+  /**
+   * @brief reserve storage for the specified number of items and pages
+   * could be used to preallocate containers prior to building large menus
+   * and avoid memory reallocations and heap fragmentation
+   * 
+   * @param items_num number of items
+   * @param pages_num number of pages
+   */
+  void reserve(size_t items_num, size_t pages_num);
+
   /**
    * @brief generate next available id for the item
    * 
@@ -346,6 +622,49 @@ public:
    */
   muiItemId makePage(const char* name = nullptr, muiItemId parent = 0, item_opts options = item_opts());
 
+  /**
+   * @brief create new lazy page
+   * page's items are not created until page is visited for the first time, on switching to the page
+   * builder is called to create items. Items created by builder could be destroyed later on
+   * to free memory (see setPagesBudget()), then builder will be called again on next visit.
+   * @note builder should not create pages, only items
+   * 
+   * @param name - page label. Pointer MUST persist while page exists!
+   * @param parent - parent page id, 0 - if it is a root page
+   * @param builder - callback that creates page items
+   * @param options - options struct
+   * @return muiItemId 
+   */
+  muiItemId makePage(const char* name, muiItemId parent, muipp::page_builder_t builder, item_opts options = item_opts());
+
+  /**
+   * @brief rename page
+   * page labels index is updated, so that page could be found with goPageLbl() by it's new name.
+   * Pages should not be renamed with MuiItem::setName(), or with rewriting the name buffer in place
+   * 
+   * @param page_id - page id
+   * @param name - new page label. Pointer MUST persist while page exists!
+   * @return mui_err_t id_err if page not found
+   */
+  mui_err_t setPageName(muiItemId page_id, const char* name);
+
+  /**
+   * @brief set max number of items created by lazy pages to keep in memory
+   * when this number is exceeded, least recently visited lazy pages are evicted, i.e. their items are destroyed.
+   * Current page and the page displayed on screen are never evicted
+   * 
+   * @param items_num max number of items, 0 - keep only current page's items, SIZE_MAX (default) - never evict pages
+   */
+  void setPagesBudget(size_t items_num){ _lazy_budget = items_num; _evict_pages(); }
+
+  /**
+   * @brief destroy items of the lazy page, page will be rebuilt on next visit
+   * 
+   * @param page_id page id
+   * @return mui_err_t id_err if page is not a lazy one or it is active now
+   */
+  mui_err_t evictPage(muiItemId page_id);
+
   /**
    * @brief assign item on a page as "autoselecting"
    * i.t. this item will get focus and autoselected when switching to this page
@@ -360,10 +679,60 @@ public:
 
   mui_err_t addMuippItem(MuiItem *item, muiItemId page_id = 0){ return addMuippItem(MuiItem_pt(item), page_id); };
 
+  /**
+   * @brief add statically allocated item, container does not take ownership of the item
+   * 
+   * @param item item object, MUST outlive MuiPlusPlus container
+   * @param page_id page to bind item to, 0 - do not bind
+   * @return mui_err_t 
+   */
+  mui_err_t addMuippItem(MuiItem &item, muiItemId page_id = 0){ return addMuippItem(muipp::static_item(item), page_id); };
+
+  /**
+   * @brief create an item in container's memory arena
+   * item object and it's shared pointer control block are placed in a single chunk taken from an arena,
+   * arena memory is returned to the heap at once on clear() call or container destruction.
+   * Returned pointer should be added to container with addMuippItem()
+   * @note item pointer must not be kept after container is cleared or destroyed
+   * 
+   * @tparam T item type
+   * @param args item constructor arguments
+   * @return std::shared_ptr<T> 
+   */
+  template <class T, class... Args>
+  std::shared_ptr<T> makeItem(Args&&... args){ return std::allocate_shared<T>(muipp::arena_allocator<T>(_arena), std::forward<Args>(args)...); }
+
+  /**
+   * @brief preallocate memory arena for items created with makeItem()
+   * if arena size is sufficient for all items, those will be placed in a single heap allocation
+   * 
+   * @param size size in bytes
+   */
+  void reserveArena(size_t size){ _arena.reserve(size); }
+
+  // total size of memory blocks allocated by items arena
+  size_t arenaCapacity() const { return _arena.capacity(); }
+
   //mui_err_t addMuippItem(MuiItem&& item, muiItemId page_id = 0);//{ addMuippItem( std::make_unique<MuiItem_pt>(std::move(item)), page_id); };
 
   mui_err_t addItemToPage(muiItemId item_id, muiItemId page_id);
 
+  /**
+   * @brief create pages from a table of static page descriptors
+   * pages are created in table order, items are added without taking ownership,
+   * same item could be listed on several pages. Container storage is reserved upfront,
+   * so no reallocations happen while loading the table
+   * 
+   * @param table array of page descriptors
+   * @param num number of descriptors in a table
+   * @param ids optional array of at least 'num' elements to receive ids of created pages
+   * @return mui_err_t 
+   */
+  mui_err_t addPages(const muipp::page_def_t* table, size_t num, muiItemId* ids = nullptr);
+
+  template <size_t N>
+  mui_err_t addPages(const muipp::page_def_t (&table)[N], muiItemId* ids = nullptr){ return addPages(table, N, ids); }
+
   /**
    * @brief event sink
    * will receive events to menu current page / selected item, etc...
@@ -373,6 +742,28 @@ public:
    */
   mui_event muiEvent(mui_event e);
 
+  /**
+   * @brief post event to the queue to be processed later with processEvents() call
+   * could be called from an ISR or another core, only a single producer is supported.
+   * Cursor moves posted to a full queue are not dropped, those are summed up and processed after events
+   * that are in the queue now and before events posted later
+   * 
+   * @param e input event struct
+   * @return true if event has been queued
+   * @return false if queue is full and event has been dropped
+   */
+  bool postEvent(mui_event e);
+
+  /**
+   * @brief process all queued events
+   * a run of consecutive cursor moves is collapsed into a single mui_event_t::step event
+   * with a relative offset if selected item accepts step events (see MuiItem::acceptsStep())
+   * processing stops on first non-noop reply event, remaining events are kept in queue
+   * 
+   * @return mui_event first non-noop responce event struct
+   */
+  mui_event processEvents();
+
   /**
    * @brief switch to specified page with id 'page' and (optionally) item id
    * 
@@ -402,18 +793,85 @@ public:
   /**
    * @brief render menu on screen
    * runs render call on All items on the active page
-   * @param r - pointer to a rendering engine to pass to each item
+   * @param r - rendering engine to pass to each item, i.e. menu.render(gfx)
    */
-  void render(void* r = nullptr);
+  void render(muipp::renderer_ref r = {});
 
   /**
    * @brief refresh menu
    * checks all items on page if each needs to refresh itself, runs render call on those
    * needed refresh. Could be used tp speedup partial screen refresh (if supported)
-   * @param r 
+   * Screen areas occupied by refreshed items are cleared via clear callback (if set) prior to rendering,
+   * other items that overlap cleared areas are re-rendered also. If active page has been changed since last render
+   * then areas of the previous page's items are cleared and all items of the new page are rendered.
+   * A list of updated screen areas is available via getDirtyRegions() call
+   * @param r - rendering engine to pass to each item
    * @return returns true if any of the items was refreshed
    */
-  bool refresh(void* r = nullptr);
+  bool refresh(muipp::renderer_ref r = {});
+
+  /**
+   * @brief get a list of screen areas that were updated on last refresh() call
+   * regions are merged, so list contains non-overlapping rects only.
+   * Could be used to send to display only changed parts of the screen buffer
+   * @note the list is empty after full render() call
+   */
+  const muipp::region_list_t& getDirtyRegions() const { return _dirty; }
+
+  /**
+   * @brief set callback function that will be called on refresh() to clear screen area
+   * prior to rendering items on it
+   * 
+   * @param cb 
+   */
+  void setClearCallback(muipp::rect_cb_t cb){ _clear_cb = cb; }
+
+  /**
+   * @brief set display dimensions
+   * dirty regions and areas passed to clear callback are clipped to the display,
+   * otherwise only negative coordinates are clipped
+   * 
+   * @param w display width
+   * @param h display height
+   */
+  void setDisplaySize(uint16_t w, uint16_t h){ _screen = { 0, 0, w, h }; }
+
+  /**
+   * @brief set cache for images of static items
+   * items that return true for MuiItem::cacheable() are restored from cache instead of rendering unless those request a refresh
+   * 
+   * @note cache is cleared on attach, so the same cache object could be reused for menu objects created later
+   * @param cache pointer to cache object, MUST outlive MuiPlusPlus container, nullptr to disable caching
+   */
+  void setRenderCache(MuiRenderCache* cache){ if (_cache) _cache->clear(); _cache = cache; if (_cache) _cache->clear(); }
+
+#if MUIPP_PROFILING
+  /**
+   * @brief access timing statistics of item renders, event dispatches and frames
+   * could be used to record other operations, i.e. display flush, with muipp::prof_scope
+   * @note available only if library is built with MUIPP_PROFILING=1
+   */
+  muipp::profiler& profiler(){ return _profiler; }
+#endif
+
+  /**
+   * @brief hide or unhide an item
+   * hidden item stays linked to it's pages, but it is not rendered and skipped on focus navigation,
+   * it's screen area is cleared on next refresh(). If hidden item is focused, focus moves to the next item.
+   * Item is hidden on all pages it's linked to. Same could be done with hideItem/unhideItem/hideToggle events
+   * with item id as event param
+   * 
+   * @param item_id item id
+   * @param hide true to hide, false to show
+   * @return mui_err_t id_err if item does not exist
+   */
+  mui_err_t hideItem(muiItemId item_id, bool hide = true);
+
+  // show hidden item
+  mui_err_t unhideItem(muiItemId item_id){ return hideItem(item_id, false); }
+
+  // toggle item's hidden state
+  mui_err_t hideToggle(muiItemId item_id);
 
   /** 
    * purge all pages and items
@@ -431,6 +889,21 @@ public:
 // other private methods
 private:
 
+  // render item on a current page or restore it from cache
+  void _render_item(MuiItem* itm, muipp::renderer_ref r);
+
+  // add an area clipped to the display to the dirty regions
+  void _dirty_add(const muipp::rect_t& rect){ muipp::region_add(_dirty, rect.intersection(_screen)); }
+
+  // run builder for a lazy page with specified index
+  void _build_page(size_t idx);
+
+  // destroy items of a lazy page
+  void _evict(MuiPage& page);
+
+  // evict least recently visited lazy pages until items budget is met
+  void _evict_pages();
+
   mui_event _prev_page();
 
   /**
@@ -46,9 +46,9 @@ void MuiItem_AGFX_GenericTXT::alignText(Arduino_GFX* g, int16_t w, int16_t h, mu
   g->setCursor(xadj, g->getCursorY());  // y offset is not implemented yet
 }
 
-void MuiItem_AGFX_StaticText::render(const MuiItem* parent, void* r){
-  if (!getName()) return; // do not print NULL
-  Arduino_GFX* g = static_cast<Arduino_GFX*>(r);
+void MuiItem_AGFX_StaticText::render(const MuiItem* parent, muipp::renderer_ref r){
+  Arduino_GFX* g = r.get<Arduino_GFX>();
+  if (!getName() || !g) return; // do not print NULL
   // clear area from a previous text
   g->fillRect(xx, yy, ww, hh, cfg.bgcolor);
   if (cfg.transp_bg)
@@ -63,19 +63,20 @@ void MuiItem_AGFX_StaticText::render(const MuiItem* parent, void* r){
   alignText(g, getName());
   g->getTextBounds(getName(), g->getCursorX(), g->getCursorY(), &xx, &yy, &ww, &hh);
   g->print(getName());
+  bbox = {xx, yy, ww, hh};
   refresh = false;
 }
 
 
-void MuiItem_AGFX_TextCallBack::render(const MuiItem* parent, void* r){
+void MuiItem_AGFX_TextCallBack::render(const MuiItem* parent, muipp::renderer_ref r){
 /*
   if (_font)
-    static_cast<Arduino_GFX*>(r)->setFont(_font);
+    r.get<Arduino_GFX>()->setFont(_font);
 
-  static_cast<Arduino_GFX*>(r)->setCursor(_font);
+  r.get<Arduino_GFX>()->setCursor(_font);
 
   auto a = getXoffset(name);
-  static_cast<Arduino_GFX*>(r)->print(a, _y, _cb());
+  r.get<Arduino_GFX>()->print(a, _y, _cb());
 */
   }
   
@@ -92,7 +93,7 @@ void CanvasTextScroller::begin(const char* text, const uint8_t* font, uint8_t fo
   _c.setTextWrap(false);
   _c.getTextBounds(_text, 0, _c.height(), &xx, &yy, &ww, &hh);
   _xPos = _c.width(); // Start from the right edge
-  _lastUpdate = millis();
+  _lastUpdate = muipp::clock_ms();
   _inactive = false;
 }
 
@@ -104,7 +105,7 @@ void CanvasTextScroller::update(const char* text){
 
 bool CanvasTextScroller::scroll_pending() const {
   if (!_text) return false;
-  unsigned long now = millis();
+  unsigned long now = muipp::clock_ms();
   unsigned long elapsed = now - _lastUpdate;
   float newPos = _xPos - _speed * elapsed;
   // find if time for one px shift has passed
@@ -120,7 +121,7 @@ bool CanvasTextScroller::scroll() {
       _cb(event_t::end);
   }
 
-  unsigned long now = millis();
+  unsigned long now = muipp::clock_ms();
   unsigned long elapsed = now - _lastUpdate;
   float newPos = _xPos - _speed * elapsed;
   // find if time for one px shift has passed
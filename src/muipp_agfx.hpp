@@ -25,6 +25,12 @@
 #include "canvas/Arduino_Canvas_Mono.h"
 #include "muiplusplus.hpp"
 
+namespace muipp {
+// any ArduinoGFX display or canvas is passed to items as Arduino_GFX
+template <typename R>
+struct renderer_type<R, std::enable_if_t< std::is_base_of_v<Arduino_GFX, R> > > { using type = Arduino_GFX; };
+} // namespace muipp
+
 /**
  * @brief aggregate holds options to print text at some pont
  * 
@@ -111,7 +117,7 @@ public:
   : MuiItem_AGFX_GenericTXT(xy, tcfg),
     MuiItem_Uncontrollable(id, text) {};
   
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
 };
   
 
@@ -139,7 +145,7 @@ public:
         MuiItem_Uncontrollable(id), _cb(callback) {};
       
 
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
 };
 
 
@@ -164,7 +170,7 @@ public:
    * if function returns true - abort current render and wait for the next call, could be used to reload the scroll text when reaching certain portions of the screen
    * if function returns false - keep rendering the text
    */
-  using event_cb = std::function< bool (event_t e)>;
+  using event_cb = muipp::delegate< bool (event_t e)>;
 
   /**
    * @brief begin scrolling text
@@ -219,7 +225,7 @@ public:
   const uint8_t* getFramebuffer(){ return _c.getFramebuffer(); }
 
   // reset current scroller position, start the text from right edge
-  void reset(){ _xPos = _c.width(); _lastUpdate = millis(); };
+  void reset(){ _xPos = _c.width(); _lastUpdate = muipp::clock_ms(); };
 
   int16_t getW() const { return _c.width(); }
   int16_t getH() const { return _c.height(); }
@@ -286,7 +292,7 @@ public:
 
   // begin text scrolling with predefined font settings
   void begin(const char* text){ CanvasTextScroller::begin(text, _tcfg.font, _tcfg.font_size); };
-  void render(const MuiItem* parent, void* r = nullptr) override { if (scroll()) static_cast<Arduino_GFX*>(r)->drawBitmap(_x, _y, _c.getFramebuffer(), getW(), getH(), _tcfg.color, _tcfg.bgcolor); };
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override { auto g = r.get<Arduino_GFX>(); if (g && scroll()) g->drawBitmap(_x, _y, _c.getFramebuffer(), getW(), getH(), _tcfg.color, _tcfg.bgcolor); bbox = {_x, _y, static_cast<uint16_t>(getW()), static_cast<uint16_t>(getH())}; };
   bool refresh_req() const override { return scroll_pending(); };
 };
 
@@ -20,6 +20,16 @@
 */
 
 #include "muipp_tpl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#ifdef BUILD_FOR_PICO_CMAKE
+#include "pico/time.h"
+#elif defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
 
 namespace muipp {
 
@@ -72,4 +82,297 @@ std::tuple<int16_t, int16_t, uint16_t, uint16_t> grid_box::getBoxDimensions(int1
   return { xx, yy, ww, hh };
 }
 
-}
\ No newline at end of file
+bool rect_t::intersects(const rect_t& r) const {
+  return  x < r.x + r.w && r.x < x + w &&
+          y < r.y + r.h && r.y < y + h;
+}
+
+void rect_t::merge(const rect_t& r){
+  if (r.empty()) return;
+  if (empty()){
+    *this = r;
+    return;
+  }
+  int32_t x1 = std::max<int32_t>(x + w, r.x + r.w);
+  int32_t y1 = std::max<int32_t>(y + h, r.y + r.h);
+  x = std::min(x, r.x);
+  y = std::min(y, r.y);
+  w = std::min<int32_t>(x1 - x, UINT16_MAX);
+  h = std::min<int32_t>(y1 - y, UINT16_MAX);
+}
+
+rect_t rect_t::intersection(const rect_t& r) const {
+  int32_t x0 = std::max<int32_t>(x, r.x);
+  int32_t y0 = std::max<int32_t>(y, r.y);
+  int32_t x1 = std::min<int32_t>(x + w, r.x + r.w);
+  int32_t y1 = std::min<int32_t>(y + h, r.y + r.h);
+  if (x0 >= x1 || y0 >= y1) return {};
+  return { static_cast<int16_t>(x0), static_cast<int16_t>(y0), static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0) };
+}
+
+void region_add(region_list_t& regions, rect_t r){
+  if (r.empty()) return;
+  // merged rect could overlap other regions in a list, so keep merging until no more intersections left
+  for (auto i = regions.begin(); i != regions.end(); ){
+    if (i->intersects(r)){
+      r.merge(*i);
+      regions.erase(i);
+      i = regions.begin();
+    } else
+      ++i;
+  }
+  regions.push_back(r);
+}
+
+void arena::_add_block(size_t size){
+  // block header takes max_align_t space, so that chunks are aligned
+  size_t hdr = _chunk_size(sizeof(block_t));
+  size = std::max(size, _block_size);
+  auto b = static_cast<block_t*>(::operator new(hdr + size));
+  b->next = _blocks;
+  _blocks = b;
+  _ptr = reinterpret_cast<unsigned char*>(b) + hdr;
+  _end = _ptr + size;
+  _capacity += hdr + size;
+}
+
+void* arena::allocate(size_t size, size_t align){
+  size = _chunk_size(size);
+  align = std::max(align, alignof(std::max_align_t));
+  // reuse a freed chunk of the same size
+  for (chunk_t** c = &_free; *c; c = &(*c)->next){
+    if ((*c)->size == size && !(reinterpret_cast<uintptr_t>(*c) & (align - 1))){
+      void* p = *c;
+      *c = (*c)->next;
+      return p;
+    }
+  }
+
+  // padding needed for over-aligned chunk, block is allocated with some spare space for it
+  size_t pad = -reinterpret_cast<uintptr_t>(_ptr) & (align - 1);
+  if (static_cast<size_t>(_end - _ptr) < pad + size){
+    _add_block(size + align - alignof(std::max_align_t));
+    pad = -reinterpret_cast<uintptr_t>(_ptr) & (align - 1);
+  }
+  // padding is a multiple of max_align_t, so it is large enough to be kept in a free list
+  if (pad)
+    deallocate(_ptr, pad);
+  void* p = _ptr + pad;
+  _ptr += pad + size;
+  return p;
+}
+
+void arena::deallocate(void* p, size_t size){
+  if (!p) return;
+  auto c = static_cast<chunk_t*>(p);
+  c->size = _chunk_size(size);
+  c->next = _free;
+  _free = c;
+}
+
+void arena::reserve(size_t size){
+  size = _chunk_size(size);
+  if (static_cast<size_t>(_end - _ptr) < size)
+    _add_block(size);
+}
+
+void arena::release(){
+  while (_blocks){
+    block_t* b = _blocks;
+    _blocks = b->next;
+    ::operator delete(b);
+  }
+  _free = nullptr;
+  _ptr = _end = nullptr;
+  _capacity = 0;
+}
+
+void bitmap::resize(size_t n){
+  // clear bits beyond the old size in the last word, so that grown bits are zero
+  if (n > _size && _size % 32)
+    _w[_size / 32] &= (1u << (_size % 32)) - 1;
+  _w.resize((n + 31) / 32, 0);
+  _size = n;
+}
+
+void bitmap::erase(size_t i){
+  if (i >= _size) return;
+  size_t w = i / 32;
+  // shift down bits above i in it's word, then carry the lowest bit of each next word
+  uint32_t low = _w[w] & ((1u << (i % 32)) - 1);
+  _w[w] = low | ((_w[w] >> 1) & ~((1u << (i % 32)) - 1));
+  for (; w + 1 < _w.size(); ++w){
+    _w[w] = (_w[w] & 0x7fffffff) | (_w[w + 1] << 31);
+    _w[w + 1] >>= 1;
+  }
+  resize(_size - 1);
+}
+
+bool bitmap::any() const {
+  return find_next(0) != npos;
+}
+
+size_t bitmap::find_next(size_t from) const {
+  if (from >= _size) return npos;
+  size_t w = from / 32;
+  uint32_t bits = _w[w] & (~0u << (from % 32));
+  for (;;){
+    if (bits){
+      size_t i = w * 32 + __builtin_ctz(bits);
+      return i < _size ? i : npos;
+    }
+    if (++w == _w.size()) return npos;
+    bits = _w[w];
+  }
+}
+
+size_t bitmap::find_prev(size_t from) const {
+  if (!_size) return npos;
+  from = std::min(from, _size - 1);
+  size_t w = from / 32;
+  uint32_t bits = _w[w] & (~0u >> (31 - from % 32));
+  for (;;){
+    if (bits)
+      return w * 32 + 31 - __builtin_clz(bits);
+    if (w-- == 0) return npos;
+    bits = _w[w];
+  }
+}
+
+int32_t accelerator_t::apply(int32_t steps, uint32_t now){
+  uint32_t dt = now - _last;
+  _last = now;
+  if (!threshold || !steps) return steps;
+
+  // input has paused, start over
+  if (dt > 250) _rate = 0;
+  uint32_t n = steps < 0 ? -steps : steps;
+  // steps processed within the same ms are counted as 1 ms apart, rate is averaged to filter out encoder jitter
+  _rate = (_rate + n * 1000 / std::max<uint32_t>(dt, 1)) / 2;
+  int32_t factor = std::clamp<uint32_t>(_rate / threshold, 1, std::max<uint16_t>(max_factor, 1));
+  return steps * factor;
+}
+
+void profiler::record(prof_kind_t kind, muiItemId id, uint32_t us){
+  if (kind == prof_kind_t::frame && us > budget)
+    ++_overruns;
+
+  auto i = std::find_if(_stats.begin(), _stats.begin() + _size, [kind, id](const prof_stat_t& s){ return s.kind == kind && s.id == id; });
+  if (i == _stats.begin() + _size){
+    // take a free slot or replace the oldest one
+    if (_size < _stats.size())
+      i = _stats.begin() + _size++;
+    else {
+      i = _stats.begin() + _next;
+      _next = (_next + 1) % _stats.size();
+    }
+    *i = { id, kind, 0, UINT32_MAX, 0, 0 };
+  }
+  ++i->count;
+  i->min = std::min(i->min, us);
+  i->max = std::max(i->max, us);
+  i->total += us;
+}
+
+const prof_stat_t* profiler::find(prof_kind_t kind, muiItemId id) const {
+  auto i = std::find_if(begin(), end(), [kind, id](const prof_stat_t& s){ return s.kind == kind && s.id == id; });
+  return i == end() ? nullptr : i;
+}
+
+void profiler::dump(std::FILE* f) const {
+  static constexpr const char* kinds[] = { "render", "event", "frame", "flush" };
+  std::fprintf(f, "kind      id    count    min us   avg us   max us\n");
+  for (const auto &s : *this)
+    std::fprintf(f, "%-6s %5lu %8lu %9lu %8lu %8lu%s\n", kinds[static_cast<size_t>(s.kind)], static_cast<unsigned long>(s.id),
+      static_cast<unsigned long>(s.count), static_cast<unsigned long>(s.min), static_cast<unsigned long>(s.avg()), static_cast<unsigned long>(s.max),
+      s.max > budget ? " !" : "");
+  std::fprintf(f, "frames over %lu us budget: %lu\n", static_cast<unsigned long>(budget), static_cast<unsigned long>(_overruns));
+}
+
+size_t format_fixed(char* buf, size_t size, double value, uint8_t decimals){
+  if (!size) return 0;
+  decimals = std::min<uint8_t>(decimals, 9);
+  uint64_t scale = 1;
+  for (uint8_t i = 0; i != decimals; ++i)
+    scale *= 10;
+
+  double a = value < 0 ? -value : value;
+  // nan, inf or a value that does not fit into scaled integer is printed as a marker, truncated to the buffer size
+  if (!(a * scale < 1.8e19)){
+    const char* mark = std::isnan(value) ? "nan" : std::isinf(value) ? (value < 0 ? "-inf" : "inf") : (value < 0 ? "-ovf" : "ovf");
+    size_t len = std::min<size_t>(std::strlen(mark), size - 1);
+    std::memcpy(buf, mark, len);
+    buf[len] = 0;
+    return len;
+  }
+
+  uint64_t scaled = static_cast<uint64_t>(a * scale + 0.5);
+  char* p = buf;
+  char* end = buf + size - 1;
+  if (value < 0 && scaled && p != end)
+    *p++ = '-';
+  auto res = std::to_chars(p, end, scaled / scale);
+  if (res.ec != std::errc()){
+    *buf = 0;
+    return 0;
+  }
+  p = res.ptr;
+
+  if (decimals && p != end){
+    *p++ = '.';
+    // fractional part with leading zeroes
+    char frac[9];
+    uint64_t f = scaled % scale;
+    for (int i = decimals - 1; i >= 0; --i){
+      frac[i] = '0' + f % 10;
+      f /= 10;
+    }
+    size_t len = std::min<size_t>(decimals, end - p);
+    std::memcpy(p, frac, len);
+    p += len;
+  }
+  *p = 0;
+  return p - buf;
+}
+
+// custom clock source, system clock is used if not set
+static clock_source_t _clock_src{nullptr};
+
+void set_clock(clock_source_t src){ _clock_src = src; }
+
+uint32_t clock_ms(){
+  if (_clock_src)
+    return _clock_src();
+#ifdef BUILD_FOR_PICO_CMAKE
+  return static_cast<uint32_t>(time_us_64() / 1000);
+#elif defined(ARDUINO)
+  return millis();
+#else
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+uint32_t clock_us(){
+#ifdef BUILD_FOR_PICO_CMAKE
+  return time_us_32();
+#elif defined(ARDUINO)
+  return micros();
+#else
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void tween_t::start(int32_t offset, uint32_t duration, uint32_t now){
+  _from = duration ? offset + value(now) : 0;
+  _t0 = now;
+  _duration = duration;
+}
+
+int32_t tween_t::value(uint32_t now) const {
+  if (!active(now)) return 0;
+  // ease-out quad, remaining distance is from * (1 - t)^2
+  int64_t left = _duration - (now - _t0);
+  return static_cast<int32_t>(_from * left * left / (static_cast<int64_t>(_duration) * _duration));
+}
+
+}
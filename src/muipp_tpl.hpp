@@ -20,32 +20,589 @@
 */
 
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
 #include <functional>
 #include <string_view>
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
 
 using muiItemId = uint32_t;
 
+// size of memory blocks allocated by muipp::arena
+#ifndef MUIPP_ARENA_BLOCK_SIZE
+#define MUIPP_ARENA_BLOCK_SIZE 1024
+#endif
+
+// minimal time between animation frames, ms (~60 fps)
+#ifndef MUIPP_FRAME_TIME_MS
+#define MUIPP_FRAME_TIME_MS 16
+#endif
+
+// collect render/event timing statistics in MuiPlusPlus, disabled by default
+#ifndef MUIPP_PROFILING
+#define MUIPP_PROFILING 0
+#endif
+
+// number of statistics slots kept by muipp::profiler
+#ifndef MUIPP_PROFILER_SLOTS
+#define MUIPP_PROFILER_SLOTS 16
+#endif
+
 namespace muipp {
 
+// invalid index value, used to denote "no position" for indexes in containers
+static constexpr size_t npos = SIZE_MAX;
+
+/**
+ * @brief FNV-1a hash of a null-terminated string
+ * 
+ * @param s string
+ * @return uint32_t 
+ */
+constexpr uint32_t fnv1a(const char* s){
+  uint32_t h = 2166136261u;
+  while (*s){
+    h ^= static_cast<uint8_t>(*s++);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+/**
+ * @brief growable set of bits packed into 32 bit words
+ * search for set bits scans whole words, so it skips up to 32 cleared bits at once
+ */
+class bitmap {
+  std::vector<uint32_t> _w;
+  size_t _size{0};
+
+public:
+  size_t size() const { return _size; }
+
+  // change number of bits, new bits are cleared
+  void resize(size_t n);
+
+  void clear(){ _w.clear(); _size = 0; }
+
+  bool test(size_t i) const { return i < _size && (_w[i / 32] >> (i % 32) & 1); }
+
+  void set(size_t i, bool v = true){ if (v) _w[i / 32] |= 1u << (i % 32); else _w[i / 32] &= ~(1u << (i % 32)); }
+
+  void push_back(bool v){ resize(_size + 1); set(_size - 1, v); }
+
+  // remove a bit, higher bits are shifted down
+  void erase(size_t i);
+
+  // returns true if any bit is set
+  bool any() const;
+
+  // index of the first set bit starting from 'from', npos if none
+  size_t find_next(size_t from) const;
+
+  // index of the last set bit at or before 'from' (the last bit if 'from' is out of range), npos if none
+  size_t find_prev(size_t from) const;
+};
+
+/**
+ * @brief lightweight callable wrapper, a replacement for std::function that never allocates memory
+ * callable object (function pointer, lambda, functor) is stored inline in a fixed size buffer,
+ * objects that do not fit into buffer are rejected at compile time. Default buffer size fits a pointer to function
+ * or a lambda capturing up to two pointers (i.e. [this] or [&a, &b])
+ * 
+ * @tparam Signature function signature, i.e. void (size_t)
+ * @tparam Size inline storage size in bytes
+ */
+template <typename Signature, size_t Size = 2 * sizeof(void*)>
+class delegate;
+
+template <typename R, typename... Args, size_t Size>
+class delegate<R(Args...), Size> {
+  enum class op_t { copy, destroy };
+  using invoke_t = R (*)(void* obj, Args... args);
+  using manage_t = void (*)(op_t op, void* dst, const void* src);
+
+  alignas(std::max_align_t) mutable unsigned char _obj[Size];
+  invoke_t _invoke{nullptr};
+  // copy/destroy handler, it is null for trivial callables which are copied as raw bytes
+  manage_t _manage{nullptr};
+
+  template <typename F>
+  void _bind(F&& f){
+    using T = std::decay_t<F>;
+    static_assert(sizeof(T) <= Size, "callable object does not fit into delegate's storage, reduce captures or increase delegate Size");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "callable object alignment is not supported");
+    if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>){
+      // null function pointer makes an empty delegate
+      if (!f) return;
+    }
+    ::new (static_cast<void*>(_obj)) T(std::forward<F>(f));
+    _invoke = [](void* obj, Args... args) -> R {
+      if constexpr (std::is_void_v<R>)
+        std::invoke(*static_cast<T*>(obj), std::forward<Args>(args)...);
+      else
+        return std::invoke(*static_cast<T*>(obj), std::forward<Args>(args)...);
+    };
+    if constexpr (!std::is_trivially_copyable_v<T> || !std::is_trivially_destructible_v<T>){
+      _manage = [](op_t op, void* dst, const void* src){
+        if (op == op_t::copy)
+          ::new (dst) T(*static_cast<const T*>(src));
+        else
+          static_cast<T*>(dst)->~T();
+      };
+    }
+  }
+
+  void _copy(const delegate& other){
+    if (other._manage)
+      other._manage(op_t::copy, _obj, other._obj);
+    else
+      std::memcpy(_obj, other._obj, Size);
+    _invoke = other._invoke;
+    _manage = other._manage;
+  }
+
+public:
+  delegate() = default;
+  delegate(std::nullptr_t){}
+  delegate(const delegate& other){ _copy(other); }
+
+  template <typename F, typename = std::enable_if_t< !std::is_same_v<std::decay_t<F>, delegate> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...> > >
+  delegate(F&& f){ _bind(std::forward<F>(f)); }
+
+  ~delegate(){ reset(); }
+
+  delegate& operator=(const delegate& other){ if (this != &other){ reset(); _copy(other); } return *this; }
+  delegate& operator=(std::nullptr_t){ reset(); return *this; }
+
+  // release stored callable, delegate becomes empty
+  void reset(){
+    if (_manage)
+      _manage(op_t::destroy, _obj, nullptr);
+    _invoke = nullptr;
+    _manage = nullptr;
+  }
+
+  explicit operator bool() const { return _invoke != nullptr; }
+
+  // call stored callable, calling an empty delegate is undefined
+  R operator()(Args... args) const { return _invoke(_obj, std::forward<Args>(args)...); }
+};
+
 // callback function that returns index size
-using size_cb_t = std::function< size_t (void)>;
+using size_cb_t = delegate< size_t (void)>;
 // callback function that accepts index value
-using index_cb_t = std::function< void (size_t index)>;
+using index_cb_t = delegate< void (size_t index)>;
+// callback function that takes no arguments, i.e. some action handler
+using action_cb_t = delegate< void (void)>;
 // callback that just returns string
-using string_cb_t = std::function< const char* (void)>;
+using string_cb_t = delegate< const char* (void)>;
 // callback function that accepts index and returns const char* string associated with index
-using stringbyindex_cb_t = std::function< const char* (size_t index)>;
+using stringbyindex_cb_t = delegate< const char* (size_t index)>;
 // callback function for constrained numeric
 template <typename T>
-using constrain_val_cb_t = std::function< void (muiItemId id, T value, T min, T max, T step)>;
+using constrain_val_cb_t = delegate< void (muiItemId id, T value, T min, T max, T step)>;
 // stringifying function, it accepts some object value and returns a string that identifies the value (i.e. convert int to asci, etc...)
 template <typename T>
-using stringify_cb_t = std::function< std::string (T value)>;
+using stringify_cb_t = delegate< std::string (T value)>;
+// formatting function, it prints some object value into provided buffer of specified size and returns length of the string
+template <typename T>
+using format_cb_t = delegate< size_t (T value, char* buf, size_t size)>;
 
 // callback function that returns something by value :) mostly usefull with POD objects - ints, floats, etc...
 template <typename T>
-using value_cb_t = std::function< T (void)>;
+using value_cb_t = delegate< T (void)>;
+
+/**
+ * @brief renderer type items receive for a backend object type
+ * backends specialize it to pass their whole class hierarchy as a single base type,
+ * i.e. any ArduinoGFX display or canvas is passed to items as Arduino_GFX
+ */
+template <typename R, typename = void>
+struct renderer_type { using type = R; };
+
+/**
+ * @brief typed reference to a rendering engine that is passed to items on render
+ * renderer is bound along with it's type at compile time, item gets it back with get<T>() which returns
+ * nullptr if the renderer is of some other type. Item then makes direct calls to the backend,
+ * there are no casts or virtual calls per drawing primitive
+ */
+class renderer_ref {
+  void* _r{nullptr};
+  const void* _type{nullptr};
+
+  // unique address per type is used as type id, works without RTTI
+  template <typename T>
+  static const void* _type_id(){ static char id; return &id; }
+
+public:
+  renderer_ref() = default;
+  renderer_ref(std::nullptr_t){}
+
+  template <typename R, typename T = typename renderer_type<std::remove_cv_t<R>>::type, typename = std::enable_if_t< !std::is_same_v<std::remove_cv_t<R>, renderer_ref> > >
+  renderer_ref(R& r) : _r(static_cast<T*>(&r)), _type(_type_id<T>()) {}
+
+  // get renderer of a specified type, returns nullptr if no renderer is set or it is of a different type
+  template <typename T>
+  T* get() const { return _type == _type_id<T>() ? static_cast<T*>(_r) : nullptr; }
+
+  explicit operator bool() const { return _r; }
+};
+
+// clock source function, returns monotonic time in milliseconds
+using clock_source_t = uint32_t (*)();
+
+/**
+ * @brief monotonic clock used for animations, input acceleration and text scrolling
+ * it is time_us_64() for Pico SDK builds, millis() for Arduino and steady_clock otherwise,
+ * unless a custom source is set with set_clock()
+ * 
+ * @return uint32_t time in milliseconds, wraps around
+ */
+uint32_t clock_ms();
+
+/**
+ * @brief replace the clock used by clock_ms()
+ * i.e. to run menus with simulated time and replay recorded events deterministically
+ * 
+ * @param src clock function, nullptr to restore system clock
+ */
+void set_clock(clock_source_t src);
+
+/**
+ * @brief monotonic clock with microseconds resolution, used for profiling
+ * it is always a system clock, since it measures CPU time spent
+ * 
+ * @return uint32_t time in microseconds, wraps around
+ */
+uint32_t clock_us();
+
+/**
+ * @brief time based tween that brings an offset value down to zero
+ * used for smooth animations, i.e. item is drawn at target position plus tween's value,
+ * value decays with ease-out curve over animation duration
+ */
+class tween_t {
+  int32_t _from{0};
+  uint32_t _t0{0}, _duration{0};
+
+public:
+  /**
+   * @brief start animation from an offset
+   * if animation is still running, new offset is added to the current value, so movement stays continuous
+   * 
+   * @param offset distance from target position
+   * @param duration animation duration in ms, animation is disabled if 0
+   * @param now current time from clock_ms()
+   */
+  void start(int32_t offset, uint32_t duration, uint32_t now);
+
+  // offset value at specified time
+  int32_t value(uint32_t now) const;
+
+  // returns true if animation has not finished yet at specified time
+  bool active(uint32_t now) const { return _from && now - _t0 < _duration; }
+
+  // stop animation, value becomes zero
+  void stop(){ _from = 0; }
+};
+
+/**
+ * @brief velocity based acceleration for value inputs
+ * input rate is measured from the time between consecutive events, when it exceeds a threshold
+ * the number of steps is multiplied proportionally to the rate, so that fast encoder spins cross large ranges quickly
+ */
+class accelerator_t {
+  uint32_t _last{0};
+  // smoothed input rate, steps per second
+  uint32_t _rate{0};
+
+public:
+  // input rate in steps per second when acceleration kicks in, acceleration is disabled if 0
+  uint16_t threshold{0};
+  // max steps multiplier
+  uint16_t max_factor{10};
+
+  /**
+   * @brief apply acceleration to a number of steps
+   * 
+   * @param steps number of steps received with an event, i.e. +-1 for a cursor move
+   * @param now current time from clock_ms()
+   * @return int32_t accelerated number of steps
+   */
+  int32_t apply(int32_t steps, uint32_t now);
+};
+
+// kind of operation measured by profiler
+enum class prof_kind_t : uint8_t {
+  render = 0,   // item render, keyed by item id
+  event,        // event dispatch, keyed by focused item id or 0 for page navigation
+  frame,        // whole render()/refresh() call, keyed by page id
+  flush         // frame buffer transfer, measured by user code
+};
+
+// timing statistics for a single item/operation, times are in microseconds
+struct prof_stat_t {
+  muiItemId id;
+  prof_kind_t kind;
+  uint32_t count, min, max;
+  uint64_t total;
+
+  uint32_t avg() const { return count ? static_cast<uint32_t>(total / count) : 0; }
+};
+
+/**
+ * @brief timing statistics collector
+ * keeps min/avg/max times for a fixed number of item/operation pairs in a ring buffer,
+ * when all slots are taken, new pair replaces the oldest one. Does not allocate memory
+ */
+class profiler {
+  std::array<prof_stat_t, MUIPP_PROFILER_SLOTS> _stats{};
+  size_t _size{0}, _next{0};
+  // number of frames that took longer than a budget
+  uint32_t _overruns{0};
+
+public:
+  // frame time budget, us
+  uint32_t budget{MUIPP_FRAME_TIME_MS * 1000};
+
+  /**
+   * @brief add a measurement
+   * 
+   * @param kind operation kind
+   * @param id item or page id
+   * @param us time taken, microseconds
+   */
+  void record(prof_kind_t kind, muiItemId id, uint32_t us);
+
+  // find statistics for an item/operation pair, returns nullptr if not found
+  const prof_stat_t* find(prof_kind_t kind, muiItemId id) const;
+
+  // collected statistics
+  const prof_stat_t* begin() const { return _stats.data(); }
+  const prof_stat_t* end() const { return _stats.data() + _size; }
+  size_t size() const { return _size; }
+
+  // number of frames exceeded the time budget
+  uint32_t overruns() const { return _overruns; }
+
+  // drop all statistics
+  void reset(){ _size = _next = 0; _overruns = 0; }
+
+  /**
+   * @brief print statistics as a table, i.e. to stdout or a serial port
+   * 
+   * @param f stream to print to
+   */
+  void dump(std::FILE* f = stdout) const;
+};
+
+/**
+ * @brief measures time of a scope and records it into profiler on scope exit
+ */
+class prof_scope {
+  profiler& _p;
+  prof_kind_t _kind;
+  muiItemId _id;
+  uint32_t _t0;
+  bool _active{true};
+
+public:
+  prof_scope(profiler& p, prof_kind_t kind, muiItemId id) : _p(p), _kind(kind), _id(id), _t0(clock_us()) {}
+  ~prof_scope(){ if (_active) _p.record(_kind, _id, clock_us() - _t0); }
+  prof_scope(const prof_scope&) = delete;
+  prof_scope& operator=(const prof_scope&) = delete;
+
+  // do not record this measurement, i.e. if there was nothing to do
+  void cancel(){ _active = false; }
+};
+
+/**
+ * @brief print floating point value with fixed number of decimals into a buffer
+ * does not allocate memory, unlike printf family functions with floats
+ * nan and inf are printed as "nan", "inf", values that are too large to print (|value| * 10^decimals >= 1.8e19) as "ovf"
+ * 
+ * @param buf buffer to print to, it is always null-terminated
+ * @param size buffer size
+ * @param value value to print
+ * @param decimals number of digits after decimal point, max 9
+ * @return size_t length of the printed string
+ */
+size_t format_fixed(char* buf, size_t size, double value, uint8_t decimals);
+
+/**
+ * @brief print numeric value into a buffer without memory allocations
+ * integers are printed as is, floating point values are printed with fixed number of decimals
+ * 
+ * @param buf buffer to print to, it is always null-terminated
+ * @param size buffer size
+ * @param value value to print
+ * @param decimals number of digits after decimal point for floating point values
+ * @return size_t length of the printed string
+ */
+template <typename T>
+size_t format_number(char* buf, size_t size, T value, uint8_t decimals = 6){
+  static_assert(std::is_arithmetic_v<T>, "only numeric types could be formatted");
+  if (!size) return 0;
+  if constexpr (std::is_floating_point_v<T>){
+    return format_fixed(buf, size, value, decimals);
+  } else {
+    auto res = std::to_chars(buf, buf + size - 1, value);
+    // value does not fit into buffer
+    if (res.ec != std::errc()) res.ptr = buf;
+    *res.ptr = 0;
+    return res.ptr - buf;
+  }
+}
+
+/**
+ * @brief bounded lock-free single producer / single consumer queue
+ * producer (i.e. an ISR or another core) could push elements while consumer pops it,
+ * no locks and no memory allocations are involved
+ * 
+ * @tparam T element type, should be trivially copyable
+ * @tparam N queue capacity, must be a power of 2
+ */
+template <typename T, size_t N>
+class spsc_queue {
+  static_assert(N && !(N & (N - 1)), "queue capacity must be a power of 2");
+  T _buf[N];
+  // next position to read, modified by consumer only
+  std::atomic<size_t> _head{0};
+  // next position to write, modified by producer only
+  std::atomic<size_t> _tail{0};
+
+public:
+  // producer side: add element to the queue, returns false if queue is full
+  bool push(const T& v){
+    size_t t = _tail.load(std::memory_order_relaxed);
+    if (t - _head.load(std::memory_order_acquire) == N) return false;
+    _buf[t & (N - 1)] = v;
+    _tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer side: returns pointer to the oldest element or nullptr if queue is empty
+  const T* front() const {
+    size_t h = _head.load(std::memory_order_relaxed);
+    return h == _tail.load(std::memory_order_acquire) ? nullptr : &_buf[h & (N - 1)];
+  }
+
+  // consumer side: remove oldest element, queue must not be empty
+  void pop(){ _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  // consumer side: drop all elements
+  void clear(){ _head.store(_tail.load(std::memory_order_acquire), std::memory_order_release); }
+
+  bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+};
+
+/**
+ * @brief memory arena for a set of objects that are released all at once
+ * memory is taken from large blocks allocated on the heap, so that objects do not scatter across the heap.
+ * Freed chunks are kept in a free list and reused for allocations of the same size,
+ * blocks are returned to the heap only on release() or arena destruction
+ */
+class arena {
+  // header of a memory block
+  struct block_t {
+    block_t* next;
+  };
+  // freed chunk
+  struct chunk_t {
+    chunk_t* next;
+    size_t size;
+  };
+
+  block_t* _blocks{nullptr};
+  chunk_t* _free{nullptr};
+  // free space in current block
+  unsigned char* _ptr{nullptr};
+  unsigned char* _end{nullptr};
+  size_t _block_size;
+  size_t _capacity{0};
+
+  // allocate new block with at least 'size' bytes of free space
+  void _add_block(size_t size);
+
+  // allocation size, all chunks are aligned to max_align_t and large enough to be kept in a free list
+  static size_t _chunk_size(size_t size){
+    size = std::max(size, sizeof(chunk_t));
+    return (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  }
+
+public:
+  explicit arena(size_t block_size = MUIPP_ARENA_BLOCK_SIZE) : _block_size(block_size) {}
+  ~arena(){ release(); }
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  /**
+   * @brief allocate memory chunk
+   * 
+   * @param size chunk size
+   * @param align alignment, power of 2. Chunks are always aligned to alignof(std::max_align_t),
+   * over-aligned chunks are padded, padding is kept in a free list
+   * @return void* 
+   */
+  void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+  /**
+   * @brief return memory chunk to arena, it could be reused for allocation of the same size
+   * 
+   * @param p pointer to a chunk
+   * @param size chunk size
+   */
+  void deallocate(void* p, size_t size);
+
+  /**
+   * @brief preallocate a single block with at least 'size' bytes of free space
+   * could be used to place all objects into a single heap allocation
+   * 
+   * @param size bytes
+   */
+  void reserve(size_t size);
+
+  /**
+   * @brief release all memory blocks back to the heap
+   * @note all objects allocated from arena must be destroyed prior to release
+   */
+  void release();
+
+  // total size of allocated blocks
+  size_t capacity() const { return _capacity; }
+};
+
+/**
+ * @brief STL allocator that takes memory from muipp::arena
+ * could be used with std::allocate_shared to place an object along with it's control block into an arena
+ * 
+ * @tparam T 
+ */
+template <typename T>
+struct arena_allocator {
+  using value_type = T;
+  arena* a;
+
+  explicit arena_allocator(arena& a) noexcept : a(&a) {}
+  template <typename U>
+  arena_allocator(const arena_allocator<U>& other) noexcept : a(other.a) {}
+
+  T* allocate(size_t n){ return static_cast<T*>(a->allocate(n * sizeof(T), alignof(T))); }
+  void deallocate(T* p, size_t n) noexcept { a->deallocate(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const arena_allocator<U>& other) const { return a == other.a; }
+  template <typename U>
+  bool operator!=(const arena_allocator<U>& other) const { return a != other.a; }
+};
 
 /**
  * @brief text alignment specifier
@@ -95,6 +652,49 @@ struct item_position_t {
 };
 
 
+/**
+ * @brief rectangular screen area
+ * used by items to report it's bounding box after rendering
+ * and by MuiPlusPlus to track dirty regions for partial screen refreshes
+ * 
+ */
+struct rect_t {
+  int16_t x{0}, y{0};
+  uint16_t w{0}, h{0};
+
+  // returns true if rect has zero area
+  bool empty() const { return !w || !h; }
+
+  // returns true if rect overlaps with another rect
+  bool intersects(const rect_t& r) const;
+
+  // extend rect to a bounding box that covers both rects
+  void merge(const rect_t& r);
+
+  // returns overlapping part of two rects, empty rect if those do not overlap
+  rect_t intersection(const rect_t& r) const;
+};
+
+// a special rect value that denotes a whole screen area (i.e. item's bounding box is unknown)
+static constexpr rect_t rect_fullscreen{0, 0, UINT16_MAX, UINT16_MAX};
+
+// list of screen areas
+using region_list_t = std::vector<rect_t>;
+
+// callback function that accepts a screen area, i.e. to clear it
+using rect_cb_t = delegate< void (const rect_t& rect)>;
+
+/**
+ * @brief add an area to the list of regions
+ * area will be merged with any overlapping regions in a list,
+ * so that list will always contain non-intersecting rects
+ * 
+ * @param regions list of regions
+ * @param r area to add
+ */
+void region_add(region_list_t& regions, rect_t r);
+
+
 struct grid_box {
   // grid size
   uint16_t grid_size_x, grid_size_y;
@@ -21,45 +21,14 @@
 
 // #if __has_include("U8g2lib.h")
 #include "muipp_u8g2.hpp"
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <u8g2.h> // Use the U8g2 library for Pico SDK
 
 using namespace muipp;
 
-/*
-  display a string on multiple text lines, keeping words intact where possible, and accepting \n to force a new line
-  _Originally posted by @LenShustek in https://github.com/olikraus/u8g2/discussions/1479#discussioncomment-6242771_
-*/
-void printwords(u8g2_t &u8g2, const char *msg, int xloc, int yloc /*bottom*/ ) {
-   int dspwidth = u8g2_GetDisplayWidth(&u8g2); // display width in pixels
-   int strwidth = 0;  // string width in pixels
-   char glyph[2]; glyph[1] = 0;
-   for (const char *ptr = msg, *lastblank = NULL; *ptr; ++ptr) {
-      while (xloc == 0 && (*msg == ' ' || *msg == '\n'))
-         if (ptr == msg++) ++ptr; // skip blanks and newlines at the left edge
-      glyph[0] = *ptr;
-      strwidth += u8g2_GetStrWidth(&u8g2, glyph); // accumulate the pixel width
-      if (*ptr == ' ')  lastblank = ptr; // remember where the last blank was
-      else ++strwidth; // non-blanks will be separated by one additional pixel
-      if (*ptr == '\n' ||   // if we found a newline character,
-            xloc + strwidth > dspwidth) { // or if we ran past the right edge of the display
-         int starting_xloc = xloc;
-         // print to just before the last blank, or to just before where we got to
-         while (msg < (lastblank ? lastblank : ptr)) {
-            glyph[0] = *msg++;
-            xloc += u8g2_DrawStr(&u8g2, xloc, yloc, glyph); }
-         strwidth -= xloc - starting_xloc; // account for what we printed
-         yloc += u8g2_GetMaxCharHeight(&u8g2); // advance to the next line
-         xloc = 0; lastblank = NULL; } }
-   while (*msg) { // print any characters left over
-      glyph[0] = *msg++;
-      xloc += u8g2_DrawStr(&u8g2, xloc, yloc, glyph); } 
-}
-
-
-
-u8g2_uint_t Item_U8g2_Generic::getXoffset(u8g2_uint_t x, text_align_t halign, text_align_t valign, const char* text){
-  // set vertical position for cursor
+void Item_U8g2_Generic::setFontPos(text_align_t valign){
   switch (valign){
     case text_align_t::top :
       u8g2_SetFontPosTop(&_u8g2);
@@ -73,17 +42,22 @@ u8g2_uint_t Item_U8g2_Generic::getXoffset(u8g2_uint_t x, text_align_t halign, te
     default:
       u8g2_SetFontPosBaseline(&_u8g2);
   }
+}
+
+u8g2_uint_t Item_U8g2_Generic::getXoffset(u8g2_uint_t x, text_align_t halign, text_align_t valign, const char* text){
+  // set vertical position for cursor
+  setFontPos(valign);
 
   u8g2_uint_t xadj;
   // find horizontal position for cursor
   switch (halign){
     // try to align text centered to defined _x, _y point
     case text_align_t::center :
-      xadj = x - u8g2_GetUTF8Width(&_u8g2, text)/2;
+      xadj = x - getTextWidth(text)/2;
       break;
     // calculate left offset from the specified x position to fit the string
     case text_align_t::right :
-      xadj = x - u8g2_GetUTF8Width(&_u8g2, text);
+      xadj = x - getTextWidth(text);
       break;
     default:
       xadj = x;
@@ -92,39 +66,372 @@ u8g2_uint_t Item_U8g2_Generic::getXoffset(u8g2_uint_t x, text_align_t halign, te
   return xadj;
 }
 
+u8g2_uint_t Item_U8g2_Generic::getTextWidth(const char* text){
+  if (!text) return 0;
+  uint32_t hash = fnv1a(text);
+  for (const auto &c : _wcache){
+    if (c.text == text && c.font == _u8g2.font && c.hash == hash)
+      return c.w;
+  }
+  // replace oldest entry
+  auto &c = _wcache[_wcache_next];
+  _wcache_next = (_wcache_next + 1) % _wcache.size();
+  c = { text, _u8g2.font, hash, u8g2_GetUTF8Width(&_u8g2, text) };
+  return c.w;
+}
+
+muipp::rect_t Item_U8g2_Generic::textBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, muipp::text_align_t valign, u8g2_uint_t pad){
+  int16_t a = u8g2_GetAscent(&_u8g2);
+  int16_t h = a - u8g2_GetDescent(&_u8g2);
+  int16_t top;
+  switch (valign){
+    case text_align_t::top :
+      top = y;
+      break;
+    case text_align_t::center :
+      top = y - h/2;
+      break;
+    case text_align_t::bottom :
+      top = y - h;
+      break;
+    default:
+      top = y - a;
+  }
+  return { static_cast<int16_t>(x - pad), static_cast<int16_t>(top - pad), static_cast<uint16_t>(w + 2*pad), static_cast<uint16_t>(h + 2*pad) };
+}
+
+namespace muipp {
+
+void u8g2_clear_rect(u8g2_t &u8g2, const rect_t& rect){
+  if (rect.empty()) return;
+  // clip the area to the screen dimensions
+  int32_t x0 = std::max<int32_t>(rect.x, 0);
+  int32_t y0 = std::max<int32_t>(rect.y, 0);
+  int32_t x1 = std::min<int32_t>(rect.x + rect.w, u8g2_GetDisplayWidth(&u8g2));
+  int32_t y1 = std::min<int32_t>(rect.y + rect.h, u8g2_GetDisplayHeight(&u8g2));
+  if (x0 >= x1 || y0 >= y1) return;
+  uint8_t color = u8g2_GetDrawColor(&u8g2);
+  u8g2_SetDrawColor(&u8g2, 0);
+  u8g2_DrawBox(&u8g2, x0, y0, x1 - x0, y1 - y0);
+  u8g2_SetDrawColor(&u8g2, color);
+}
+
+size_t u8g2_update_regions(u8g2_t &u8g2, const region_list_t& regions){
+  int32_t tw = u8g2_GetBufferTileWidth(&u8g2);
+  int32_t th = u8g2_GetBufferTileHeight(&u8g2);
+  // convert pixel areas to tile areas, merging tiles that became overlapped after rounding
+  region_list_t tiles;
+  for (const auto &rect : regions){
+    if (rect.empty()) continue;
+    int32_t x0 = std::max<int32_t>(rect.x, 0) / 8;
+    int32_t y0 = std::max<int32_t>(rect.y, 0) / 8;
+    int32_t x1 = std::min<int32_t>((rect.x + rect.w + 7) / 8, tw);
+    int32_t y1 = std::min<int32_t>((rect.y + rect.h + 7) / 8, th);
+    if (x0 >= x1 || y0 >= y1) continue;
+    region_add(tiles, { static_cast<int16_t>(x0), static_cast<int16_t>(y0), static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0) });
+  }
+
+  size_t cnt{0};
+  for (const auto &t : tiles){
+    u8g2_UpdateDisplayArea(&u8g2, t.x, t.y, t.w, t.h);
+    cnt += t.w * t.h;
+  }
+  return cnt;
+}
+
+mui_err_t u8g2_write_pbm(u8g2_t &u8g2, std::FILE* f){
+  const uint8_t* buf = u8g2_GetBufferPtr(&u8g2);
+  bool vertical = u8g2.ll_hvline == u8g2_ll_hvline_vertical_top_lsb;
+  if (!buf || !f || (!vertical && u8g2.ll_hvline != u8g2_ll_hvline_horizontal_right_lsb))
+    return mui_err_t::error;
+
+  size_t w = u8g2_GetBufferTileWidth(&u8g2) * 8;
+  size_t h = u8g2_GetBufferTileHeight(&u8g2) * 8;
+  std::fprintf(f, "P4\n%u %u\n", static_cast<unsigned>(w), static_cast<unsigned>(h));
+  // PBM row is packed msb first, 1 is black
+  std::vector<uint8_t> row(w / 8);
+  for (size_t y = 0; y != h; ++y){
+    for (size_t x = 0; x != w; ++x){
+      bool lit = vertical ? buf[(y / 8) * w + x] & (1 << (y % 8)) : buf[y * w / 8 + x / 8] & (0x80 >> (x % 8));
+      if (lit)
+        row[x / 8] &= ~(0x80 >> (x % 8));
+      else
+        row[x / 8] |= 0x80 >> (x % 8);
+    }
+    if (std::fwrite(row.data(), 1, row.size(), f) != row.size())
+      return mui_err_t::error;
+  }
+  return mui_err_t::ok;
+}
+
+rect_t u8g2_render_cache::_area(const MuiItem& item) const {
+  // only vertical byte layout is supported, each byte of a tile row keeps 8 pixels of a column
+  if (!u8g2_GetBufferPtr(&_u8g2) || _u8g2.ll_hvline != u8g2_ll_hvline_vertical_top_lsb) return {};
+  const rect_t& r = item.getBBox();
+  int32_t x0 = std::max<int32_t>(r.x, 0);
+  int32_t y0 = std::max<int32_t>(r.y, 0);
+  int32_t x1 = std::min<int32_t>(r.x + r.w, u8g2_GetBufferTileWidth(&_u8g2) * 8);
+  int32_t y1 = std::min<int32_t>(r.y + r.h, u8g2_GetBufferTileHeight(&_u8g2) * 8);
+  if (r.empty() || x0 >= x1 || y0 >= y1) return {};
+  return { static_cast<int16_t>(x0), static_cast<int16_t>(y0), static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0) };
+}
+
+void u8g2_render_cache::_copy(const rect_t& area, uint8_t* img, bool restore){
+  uint8_t* buf = u8g2_GetBufferPtr(&_u8g2);
+  size_t stride = u8g2_GetBufferTileWidth(&_u8g2) * 8;
+  int32_t y1 = area.y + area.h;
+  for (int32_t row = area.y / 8; row * 8 < y1; ++row){
+    uint8_t* line = buf + row * stride + area.x;
+    if (!restore){
+      std::memcpy(img, line, area.w);
+    } else {
+      // top and bottom tile rows could be shared with other items, keep pixels out of area
+      int32_t top = std::max<int32_t>(area.y - row * 8, 0);
+      int32_t bottom = std::min<int32_t>(y1 - row * 8, 8);
+      uint8_t mask = static_cast<uint8_t>((0xff << top) & (0xff >> (8 - bottom)));
+      if (mask == 0xff)
+        std::memcpy(line, img, area.w);
+      else {
+        for (size_t i = 0; i != area.w; ++i)
+          line[i] = (line[i] & ~mask) | (img[i] & mask);
+      }
+    }
+    img += area.w;
+  }
+}
+
+bool u8g2_render_cache::restore(const MuiItem& item, muiItemId page_id){
+  rect_t area = _area(item);
+  if (area.empty()) return false;
+  auto e = std::find_if(_entries.begin(), _entries.end(), [&item, page_id](const entry_t& e){ return e.item == item.id && e.page == page_id; });
+  // item might have been moved
+  if (e == _entries.end() || e->area.x != area.x || e->area.y != area.y || e->area.w != area.w || e->area.h != area.h)
+    return false;
+  _copy(area, e->data.data(), true);
+  return true;
+}
+
+void u8g2_render_cache::save(const MuiItem& item, muiItemId page_id){
+  rect_t area = _area(item);
+  if (area.empty()) return;
+  size_t len = area.w * ((area.y + area.h + 7) / 8 - area.y / 8);
+  if (len > _budget) return;
+
+  // replace previous image of the item
+  for (auto e = _entries.begin(); e != _entries.end(); ++e){
+    if (e->item == item.id && e->page == page_id){
+      _size -= e->data.size();
+      _entries.erase(e);
+      break;
+    }
+  }
+  // drop oldest images to fit into budget
+  while (_size + len > _budget){
+    _size -= _entries.front().data.size();
+    _entries.erase(_entries.begin());
+  }
+
+  _entries.push_back({ item.id, page_id, area, std::vector<uint8_t>(len) });
+  _copy(area, _entries.back().data.data(), false);
+  _size += len;
+}
+
+void u8g2_render_cache::drop(muiItemId item_id){
+  for (auto e = _entries.begin(); e != _entries.end(); ){
+    if (e->item == item_id){
+      _size -= e->data.size();
+      e = _entries.erase(e);
+    } else
+      ++e;
+  }
+}
+
+// max length of a text line in bytes, longer lines are wrapped
+#ifndef MUIPP_TEXT_LINE_MAX
+#define MUIPP_TEXT_LINE_MAX 128
+#endif
+
+// copy text span to a null-terminated buffer
+static const char* _span(char (&buff)[MUIPP_TEXT_LINE_MAX], const char* s, size_t len){
+  len = std::min(len, sizeof(buff) - 1);
+  std::memcpy(buff, s, len);
+  buff[len] = 0;
+  return buff;
+}
+
+// returns pointer to the next UTF8 character
+static const char* _next_utf8(const char* s){
+  if (*s)
+    ++s;
+  while ((*s & 0xc0) == 0x80)
+    ++s;
+  return s;
+}
+
+void u8g2_text_layout::_build(u8g2_t &u8g2, const char* text, u8g2_uint_t x, u8g2_uint_t max_x){
+  _lines.clear();
+  char buff[MUIPP_TEXT_LINE_MAX];
+  // width of a text span
+  auto width = [&u8g2, &buff](const char* s, const char* e){ return u8g2_GetUTF8Width(&u8g2, _span(buff, s, e - s)); };
+
+  const char* p = text;
+  while (*p){
+    // skip blanks and newlines at the left edge
+    if (x == 0)
+      while (*p == ' ' || *p == '\n')
+        ++p;
+    if (!*p) break;
+
+    const char* line = p;
+    // end of the last word that fits into the line
+    const char* brk = nullptr;
+    while (*p && *p != '\n'){
+      // find the end of the next word
+      const char* e = p;
+      while (*e == ' ')
+        ++e;
+      while (*e && *e != ' ' && *e != '\n')
+        ++e;
+
+      if (e - line < MUIPP_TEXT_LINE_MAX && x + width(line, e) <= max_x){
+        p = brk = e;
+        continue;
+      }
 
-void MuiItem_U8g2_PageTitle::render(const MuiItem* parent, void* r){
+      // word does not fit, wrap the line at the last blank
+      if (brk){
+        p = brk;
+        break;
+      }
+
+      // a single word does not fit, break it at the last fitting character
+      const char* fit = line;
+      for (const char* c = _next_utf8(line); c <= e && c - line < MUIPP_TEXT_LINE_MAX && x + width(line, c) <= max_x; c = _next_utf8(c))
+        fit = c;
+
+      if (fit == line){
+        // nothing fits after x position, continue from the next line
+        if (x) break;
+        // at least one character must be printed on a line
+        fit = _next_utf8(line);
+      }
+      p = brk = fit;
+      break;
+    }
+
+    // trailing blanks are not printed
+    const char* end = brk ? brk : line;
+    while (end > line && end[-1] == ' ')
+      --end;
+    _lines.push_back({ static_cast<uint16_t>(line - text), static_cast<uint16_t>(end - line) });
+    if (*p == '\n')
+      ++p;
+    x = 0;
+  }
+}
+
+int u8g2_text_layout::print(u8g2_t &u8g2, const char* text, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t max_x){
+  if (!text) return y;
+
+  uint32_t hash = fnv1a(text);
+  if (text != _text || hash != _hash || u8g2.font != _font || x != _x || max_x != _max_x){
+    _build(u8g2, text, x, max_x);
+    _text = text;
+    _hash = hash;
+    _font = u8g2.font;
+    _x = x;
+    _max_x = max_x;
+  }
+
+  char buff[MUIPP_TEXT_LINE_MAX];
+  int yy = y;
+  for (size_t i = 0; i != _lines.size(); ++i){
+    if (i)
+      yy += u8g2_GetMaxCharHeight(&u8g2);   // advance to the next line
+    u8g2_DrawUTF8(&u8g2, i ? 0 : x, yy, _span(buff, text + _lines[i].offset, _lines[i].len));
+  }
+  return yy;
+}
+
+} // end of namespace muipp
+
+
+void MuiItem_U8g2_PageTitle::render(const MuiItem* parent, muipp::renderer_ref r){
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
 
   auto a = getXoffset(parent->getName());
-  u8g2_DrawUTF8(&_u8g2, a, _y, parent->getName());
+  auto w = u8g2_DrawUTF8(&_u8g2, a, _y, parent->getName());
+  bbox = textBox(a, _y, w, v_align);
+  refresh = false;
 }
 
-void MuiItem_U8g2_StaticText::render(const MuiItem* parent, void* r){
+void MuiItem_U8g2_StaticText::render(const MuiItem* parent, muipp::renderer_ref r){
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
+  // font position could be left changed by other items, it must match the one bbox is calculated for
+  setFontPos(v_align);
   // print text with word-wrap
-  printwords(_u8g2, name, _x, _y);
+  int ylast = _layout.print(_u8g2, name, _x, _y, u8g2_GetDisplayWidth(&_u8g2));
+  bbox = textBox(_x, _y, u8g2_GetDisplayWidth(&_u8g2) - _x, v_align);
+  // wrapped lines are printed from the left edge of the screen
+  if (ylast != _y)
+    bbox.merge(textBox(0, ylast, u8g2_GetDisplayWidth(&_u8g2), v_align));
+  refresh = false;
 }
 
-void MuiItem_U8g2_TextCallBack::render(const MuiItem* parent, void* r){
+void MuiItem_U8g2_TextCallBack::render(const MuiItem* parent, muipp::renderer_ref r){
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
 
-  auto a = getXoffset(name);
-  u8g2_DrawUTF8(&_u8g2, a, _y, _cb());
-  //// printf("TextCallBack: %s\n", _cb());
+  const char* s = _cb();
+  auto a = getXoffset(s);
+  auto w = u8g2_DrawUTF8(&_u8g2, a, _y, s);
+  //// printf("TextCallBack: %s\n", s);
+  bbox = textBox(a, _y, w, v_align);
+  refresh = false;
 }
 
 
-void MuiItem_U8g2_ActionButton::render(const MuiItem* parent, void* r){
+void MuiItem_U8g2_ProfilerOverlay::render(const MuiItem* parent, muipp::renderer_ref r){
+  if (_font)
+    u8g2_SetFont(&_u8g2, _font);
+
+  // pick entries with the longest max time
+  std::array<const muipp::prof_stat_t*, MUIPP_PROFILER_SLOTS> top;
+  size_t n = 0;
+  for (const auto &s : _prof)
+    top[n++] = &s;
+  size_t rows = std::min<size_t>(_rows, n);
+  std::partial_sort(top.begin(), top.begin() + rows, top.begin() + n, [](const muipp::prof_stat_t* a, const muipp::prof_stat_t* b){ return a->max > b->max; });
+
+  static constexpr char kinds[] = { 'R', 'E', 'F', 'S' };
+  u8g2_uint_t lh = u8g2_GetMaxCharHeight(&_u8g2);
+  setFontPos(v_align);
+  bbox = {};
+  for (size_t i = 0; i != rows; ++i){
+    // kind, id, avg and max time, 3 x 10 digits for 32 bit values
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "%c%lu %lu/%lu", kinds[static_cast<size_t>(top[i]->kind)], static_cast<unsigned long>(top[i]->id),
+      static_cast<unsigned long>(top[i]->avg()), static_cast<unsigned long>(top[i]->max));
+    u8g2_uint_t y = _y + i * lh;
+    auto w = u8g2_DrawStr(&_u8g2, _x, y, buf);
+    bbox.merge(textBox(_x, y, w, v_align));
+  }
+  _last = muipp::clock_ms();
+  refresh = false;
+}
+
+void MuiItem_U8g2_ActionButton::render(const MuiItem* parent, muipp::renderer_ref r){
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
 
   // draw button
   auto a = getXoffset(name);
   u8g2_DrawButtonUTF8(&_u8g2, a, _y, focused ? U8G2_BTN_INV : 0, 0, 1, 1, name);
+  // button adds padding and a frame around the text
+  bbox = textBox(a, _y, getTextWidth(name), v_align, 2);
+  refresh = false;
 }
 
 mui_event MuiItem_U8g2_ActionButton::muiEvent(mui_event e){
@@ -143,58 +450,183 @@ mui_event MuiItem_U8g2_ActionButton::muiEvent(mui_event e){
 //    for (; it!=end; ++it) { /*...*/ }
 //}
 
-void MuiItem_U8g2_DynamicScrollList::render(const MuiItem* parent, void* r){
+int MuiItem_U8g2_DynamicScrollList::_count(){
+  if (_size < 0){
+    _size = static_cast<int>(_size_cb());
+    // data source could have shrunk
+    if (_index >= _size)
+      _index = _size ? _size - 1 : 0;
+  }
+  return _size;
+}
+
+void MuiItem_U8g2_DynamicScrollList::_fetch_window(int first, int rows){
+  if (_labels.size() < static_cast<size_t>(rows))
+    _labels.resize(rows);
+
+  int shift = _win_start < 0 ? _win_len : first - _win_start;
+  if (shift >= 0){
+    // window moved forward, rows that are still visible are moved to the front
+    for (int i = 0; i != rows; ++i)
+      _labels[i] = (_win_start >= 0 && i + shift < _win_len) ? _labels[i + shift] : _cb(first + i);
+  } else {
+    // window moved backward, rows that are still visible are moved to the back
+    for (int i = rows - 1; i >= 0; --i)
+      _labels[i] = (i + shift >= 0 && i + shift < _win_len) ? _labels[i + shift] : _cb(first + i);
+  }
+  _win_start = first;
+  _win_len = rows;
+}
+
+void MuiItem_U8g2_DynamicScrollList::render(const MuiItem* parent, muipp::renderer_ref r){
   // printf("DynScrl print lst of %u items\n", _size_cb());
+  if (_version_cb){
+    uint32_t v = _version_cb();
+    if (v != _version){
+      _version = v;
+      _invalidate();
+    }
+  }
+
+  // current animation offsets
+  uint32_t now = muipp::clock_ms();
+  int32_t so = _scroll.value(now), ho = _hl.value(now);
+  _last_so = so;
+  _last_ho = ho;
+  _last_frame = now;
 
-  setCursor(_x, _y);
+  if (_font2 || _font)
+    u8g2_SetFont(&_u8g2, _font2 ? _font2 : _font);
   // specified cursor position will be the top reference for the Title text
   u8g2_SetFontPosTop(&_u8g2);
-
+  // rows are drawn with transparent background, display's font mode is restored when list is done
+  uint8_t font_mode = _u8g2.font_decode.is_transparent;
+  u8g2_SetFontMode(&_u8g2, 1);
+  // list takes an area from cursor position to the right edge of the screen
+  bbox = textBox(_x, _y, u8g2_GetDisplayWidth(&_u8g2) - _x, text_align_t::top, 2);
+  bbox.h += _y_shift * (_num_of_rows - 1);
+
+  int size = _count();
   // normalize index position which items should be displayed
-  int visible_idx = muipp::clamp(_index - _num_of_rows/2, 0, static_cast<int>(_size_cb()-1) );
-  for (int i = 0; i != _num_of_rows; ++i){
-    // change font for active/inactive row
-    if (visible_idx == _index && _font)
-      u8g2_SetFont(&_u8g2, _font);
-    else if (_font2)
-      u8g2_SetFont(&_u8g2, _font2);
-
-    // draw button
-    // printf("draw Dynlist_btn %u:%s\n", visible_idx, _cb(visible_idx));
-    u8g2_DrawButtonUTF8(&_u8g2, _x, _y + _y_shift*i, visible_idx == _index ? U8G2_BTN_INV : 0, 0, 1, 1, _cb(visible_idx));
-
-    if (++visible_idx >= _size_cb())
-      return;
+  int first = _first_row(_index);
+  // while list is scrolling, rows above or below visible ones are partially shown
+  int extra = (so && _y_shift > 0) ? std::min<int>((std::abs(so) + _y_shift - 1) / _y_shift, _num_of_rows) : 0;
+  int lo = so > 0 ? std::max(first - extra, 0) : first;
+  int hi = std::min(first + _num_of_rows + (so < 0 ? extra : 0), size);
+  if (listopts.cache_labels && hi > lo)
+    _fetch_window(lo, hi - lo);
+
+  // rows moving in and out of the list are clipped to it's area
+  bool clip = so || ho;
+  if (clip)
+    u8g2_SetClipWindow(&_u8g2, std::max<int>(bbox.x, 0), std::max<int>(bbox.y, 0), bbox.x + bbox.w, bbox.y + bbox.h);
+
+  const uint8_t* font = nullptr;
+  u8g2_uint_t active_w = 0;
+  for (int idx = lo; idx < hi; ++idx){
+    const char* label = listopts.cache_labels ? _labels[idx - lo] : _cb(idx);
+    // change font for active/inactive row, only when it differs from the current one
+    const uint8_t* f = (idx == _index && _font) ? _font : _font2;
+    if (f && f != font){
+      u8g2_SetFont(&_u8g2, f);
+      font = f;
+    }
+    // printf("draw Dynlist_btn %u:%s\n", idx, label);
+    u8g2_DrawUTF8(&_u8g2, _x, _y + _y_shift*(idx - first) + so, label);
+    if (idx == _index)
+      active_w = getTextWidth(label);
   }
+
+  // highlight selected row, it is drawn separately from the text to be able to slide between the rows
+  if (size){
+    const uint8_t* f = _font ? _font : _font2;
+    if (f && f != font)
+      u8g2_SetFont(&_u8g2, f);
+    u8g2_DrawButtonFrame(&_u8g2, _x, _y + _y_shift*(_index - first) + ho, U8G2_BTN_INV, active_w, 1, 1);
+  }
+
+  if (clip)
+    u8g2_SetMaxClipWindow(&_u8g2);
+  u8g2_SetFontMode(&_u8g2, font_mode);
+  refresh = false;
+}
+
+bool MuiItem_U8g2_DynamicScrollList::refresh_req() const {
+  if (refresh || (_version_cb && _version_cb() != _version))
+    return true;
+  // next animation frame is due if frame time has passed and list has moved at least by one pixel
+  uint32_t now = muipp::clock_ms();
+  return now - _last_frame >= MUIPP_FRAME_TIME_MS && (_scroll.value(now) != _last_so || _hl.value(now) != _last_ho);
+}
+
+void MuiItem_U8g2_DynamicScrollList::_animate(int old_index){
+  int f_old = _first_row(old_index), f_new = _first_row(_index);
+  // long jumps are animated as a scroll by one page
+  int32_t limit = _y_shift * _num_of_rows;
+  uint32_t now = muipp::clock_ms();
+  _scroll.start(muipp::clamp<int32_t>((f_new - f_old) * _y_shift, -limit, limit), listopts.scroll_time, now);
+  _hl.start(muipp::clamp<int32_t>((old_index - f_old - _index + f_new) * _y_shift, -limit, limit), listopts.scroll_time, now);
 }
 
 
 mui_event MuiItem_U8g2_DynamicScrollList::muiEvent(mui_event e){
   // printf("DynamicScrollList::muiEvent %u\n", static_cast<uint32_t>(e.eid));
+  int size = _count();
+  int old_index = _index;
   switch(e.eid){
     // cursor actions - move to previous position in a list
     case mui_event_t::moveUp :
     case mui_event_t::moveLeft : {
       if (_index)
         --_index;
-      else
-        _index = _size_cb() - 1;
+      else if (size)
+        _index = size - 1;
       break;
     }
     // cursor actions - move to next position in a list
     case mui_event_t::moveDown :
     case mui_event_t::moveRight : {
       ++_index;
-      if (_index == _size_cb() )
+      if (_index >= size )
         _index = 0;
       break;
     }
 
+    // relative move by a number of positions, list wraps around
+    case mui_event_t::step : {
+      if (size)
+        _index = ((_index + e.param) % size + size) % size;
+      break;
+    }
+
+    // move by a number of visible rows, list does not wrap around
+    case mui_event_t::pageUp :
+    case mui_event_t::pageDown : {
+      if (size)
+        _index = muipp::clamp(_index + (e.eid == mui_event_t::pageUp ? -_num_of_rows : _num_of_rows), 0, size - 1);
+      break;
+    }
+
+    // jump to an absolute position
+    case mui_event_t::value : {
+      if (size)
+        _index = muipp::clamp(static_cast<int>(e.param), 0, size - 1);
+      break;
+    }
+
+    // data source could have been changed while list was out of focus
+    case mui_event_t::focus : {
+      _invalidate();
+      size = _count();
+      break;
+    }
+
     case mui_event_t::enter : {
+      if (!size) break;
       // if dynamic list works as page seletor, we will stich pages here
       if (listopts.page_selector){
         // last item in a list acts as "go to previous page"
-        if (listopts.back_on_last && (_index == _size_cb() - 1))
+        if (listopts.back_on_last && (_index == size - 1))
           return mui_event(mui_event_t::prevPage);
         else  // otherwise - switch to page by it's label
           return mui_event(mui_event_t::goPageByName, 0, static_cast<void*>(const_cast<char*>(_cb(_index))) );
@@ -208,8 +640,16 @@ mui_event MuiItem_U8g2_DynamicScrollList::muiEvent(mui_event e){
     // enter acts as escape to release selection
     case mui_event_t::escape :
       return mui_event(on_escape);
+
+    // other events are not handled by the list
+    default:
+      return {};
   }
 
+  // list position has been changed
+  if (listopts.scroll_time && _index != old_index)
+    _animate(old_index);
+  refresh = true;
   return {};
 }
 
@@ -217,7 +657,7 @@ mui_event MuiItem_U8g2_DynamicScrollList::muiEvent(mui_event e){
 //  MuiItem_U8g2_CheckBox
 
 
-void MuiItem_U8g2_CheckBox::render(const MuiItem* parent, void* r){
+void MuiItem_U8g2_CheckBox::render(const MuiItem* parent, muipp::renderer_ref r){
   // u8g2_SetCursor(&_u8g2,_x, _y); // TODO?
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
@@ -235,12 +675,14 @@ void MuiItem_U8g2_CheckBox::render(const MuiItem* parent, void* r){
 
   u8g2_int_t w{0};
   if (getName()){
-    w = u8g2_GetUTF8Width(&_u8g2, getName());
+    w = getTextWidth(getName());
     a += 4;       /* add gap between the checkbox and the text area */
     u8g2_DrawUTF8(&_u8g2, _x + a, _y, getName());
   }
 
   u8g2_DrawButtonFrame(&_u8g2, _x, _y, focused ? U8G2_BTN_INV : 0, w+a, 1, 1);
+  bbox = textBox(_x, _y, w+a, text_align_t::bottom, 2);
+  refresh = false;
 }
 
 mui_event MuiItem_U8g2_CheckBox::muiEvent(mui_event e){
@@ -250,6 +692,7 @@ mui_event MuiItem_U8g2_CheckBox::muiEvent(mui_event e){
       // call a callback function to submit a new box value
       if (_action)
         _action(_v);
+      refresh = true;
       break;
     }
   }
@@ -261,13 +704,14 @@ mui_event MuiItem_U8g2_CheckBox::muiEvent(mui_event e){
 //  ***
 //  MuiItem_U8g2_ValuesList
 
-void MuiItem_U8g2_ValuesList::render(const MuiItem* parent, void* r){
+void MuiItem_U8g2_ValuesList::render(const MuiItem* parent, muipp::renderer_ref r){
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
 
   // draw label
   auto a = getXoffset(name);
-  u8g2_DrawUTF8(&_u8g2, a, _y, name);
+  auto w = u8g2_DrawUTF8(&_u8g2, a, _y, name);
+  bbox = textBox(a, _y, w, v_align);
 
   // value must be printed right after end of label
   if (_x == _xval)
@@ -288,6 +732,17 @@ void MuiItem_U8g2_ValuesList::render(const MuiItem* parent, void* r){
   auto vxoff = getXoffset(_xval, _val_halign, v_align, s);
   // draw button with frame or inversion
   u8g2_DrawButtonUTF8(&_u8g2, vxoff, _y, flags, 0, 2, 2, s);
+  bbox.merge(textBox(vxoff, _y, getTextWidth(s), v_align, 3));
+  refresh = false;
+}
+
+void MuiItem_U8g2_ValuesList::_change(int32_t steps){
+  steps = accel.apply(steps, muipp::clock_ms());
+  for (; steps < 0; ++steps)
+    _onPrev();
+  for (; steps > 0; --steps)
+    _onNext();
+  refresh = true;
 }
 
 mui_event MuiItem_U8g2_ValuesList::muiEvent(mui_event e){
@@ -295,12 +750,17 @@ mui_event MuiItem_U8g2_ValuesList::muiEvent(mui_event e){
     // cursor actions - decr value
     case mui_event_t::moveUp :
     case mui_event_t::moveLeft : 
-      _onPrev();
+      _change(-1);
       break;
     // cursor actions - incr value
     case mui_event_t::moveDown :
     case mui_event_t::moveRight :
-      _onNext();
+      _change(1);
+      break;
+
+    // switch by a number of values, item is redrawn once
+    case mui_event_t::step :
+      _change(e.param);
       break;
 
     // enter acts as escape to release selection
@@ -20,7 +20,9 @@
 */
 
 #pragma once
+#include <array>
 #include <string>
+#include <vector>
 #include <u8g2.h> // Use the U8g2 library for Pico SDK
 #include "muiplusplus.hpp"
 #include <functional>
@@ -28,6 +30,16 @@
 
 #define U8G2 u8g2_t
 
+// default memory budget for muipp::u8g2_render_cache, bytes
+#ifndef MUIPP_RENDER_CACHE_SIZE
+#define MUIPP_RENDER_CACHE_SIZE 1024
+#endif
+
+// buffer size for numeric values printed by sliders
+#ifndef MUIPP_NUMBER_STR_LEN
+#define MUIPP_NUMBER_STR_LEN 24
+#endif
+
 class Item_U8g2_Generic {
 protected:
   u8g2_t &_u8g2;
@@ -40,6 +52,18 @@ protected:
   // vertical alignment relative to cursor position
   muipp::text_align_t v_align;
 
+private:
+  // measured text width, keyed by string pointer, content hash and font
+  struct text_width_t {
+    const char* text{nullptr};
+    const uint8_t* font{nullptr};
+    uint32_t hash{0};
+    u8g2_uint_t w{0};
+  };
+  // most items measure one or two strings (i.e. label and value)
+  std::array<text_width_t, 2> _wcache{};
+  uint8_t _wcache_next{0};
+
 public:
 
   /**
@@ -61,6 +85,14 @@ public:
   // adjust text alignment
   void setTextAlignment(muipp::text_align_t hAlign, muipp::text_align_t vAlign){ h_align = hAlign; v_align = vAlign; }
 
+  /**
+   * @brief set current FontPos for specified vertical alignment, so that text is printed
+   * at the same position as calculated with textBox()
+   * 
+   * @param valign vertical alignment
+   */
+  void setFontPos(muipp::text_align_t valign);
+
   // same as getXoffset(const char* text), but for arbitrary coordinate and alignmnet
 
   /**
@@ -83,8 +115,151 @@ public:
    * (it will also adjust curent FontPos according to v_align member value)
    */
   u8g2_uint_t getXoffset(const char* text){ return getXoffset(_x, h_align, v_align, text); };
+
+  /**
+   * @brief get width of UTF8 text printed with current font
+   * measured widths are cached, so that unchanged strings are not measured glyph-by-glyph on each render.
+   * Cache is keyed by string pointer, content hash and current font, so changing item's name, string content
+   * or font would result in a new measurement
+   * 
+   * @param text 
+   * @return u8g2_uint_t text width in pixels
+   */
+  u8g2_uint_t getTextWidth(const char* text);
+
+  // drop cached text widths
+  void resetTextWidthCache(){ _wcache.fill({}); }
+
+  /**
+   * @brief calculate bounding box for a text line printed at x,y with current font
+   * 
+   * @param x, y cursor position where text is printed
+   * @param w text width
+   * @param valign vertical alignment of text relative to cursor position
+   * @param pad extra padding around the text, i.e. for button frames
+   * @return muipp::rect_t 
+   */
+  muipp::rect_t textBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, muipp::text_align_t valign, u8g2_uint_t pad = 0);
 };
 
+namespace muipp {
+
+/**
+ * @brief clear rectangular area in U8g2's buffer
+ * could be used as MuiPlusPlus clear callback for partial screen refreshes
+ * 
+ * @param u8g2 display object
+ * @param rect area to clear
+ */
+void u8g2_clear_rect(u8g2_t &u8g2, const rect_t& rect);
+
+/**
+ * @brief send to display only those parts of U8g2's buffer that are covered by specified regions
+ * regions are converted to 8x8 pixel tiles and transferred via u8g2_UpdateDisplayArea()
+ * instead of sending whole buffer with u8g2_SendBuffer()
+ * @note works only with full buffer mode (_f) U8g2 setup
+ * 
+ * @param u8g2 display object
+ * @param regions list of screen areas, i.e. MuiPlusPlus::getDirtyRegions()
+ * @return size_t number of tiles sent to display (8 bytes each)
+ */
+size_t u8g2_update_regions(u8g2_t &u8g2, const region_list_t& regions);
+
+/**
+ * @brief write U8g2's frame buffer to a stream as a binary PBM (P4) image
+ * could be used to take screenshots, i.e. to run menus on a host and compare the frames,
+ * lit display pixels are written as white
+ * @note works only with full buffer mode (_f) U8g2 setup
+ * 
+ * @param u8g2 display object
+ * @param f stream to write to
+ * @return mui_err_t error if there is no buffer or it has unsupported layout
+ */
+mui_err_t u8g2_write_pbm(u8g2_t &u8g2, std::FILE* f);
+
+/**
+ * @brief cache for images of static items in U8g2's frame buffer
+ * keeps copies of frame buffer areas covered by items, restoring an image is a memory copy
+ * instead of rendering text with fonts. When memory budget is exceeded, oldest images are dropped
+ * @note works only with full buffer mode (_f) U8g2 setup and displays with vertical byte layout (i.e. SSD1306, SH1106),
+ * for other displays nothing is cached
+ */
+class u8g2_render_cache : public MuiRenderCache {
+  struct entry_t {
+    muiItemId item, page;
+    // screen area, clipped to display dimensions
+    rect_t area;
+    std::vector<uint8_t> data;
+  };
+
+  u8g2_t& _u8g2;
+  size_t _budget;
+  // total size of cached images
+  size_t _size{0};
+  // oldest images first
+  std::vector<entry_t> _entries;
+
+  // returns item's area clipped to display and aligned to 8 pixel rows, empty if buffer layout is not supported
+  rect_t _area(const MuiItem& item) const;
+  // copy area between frame buffer and image, masking rows out of area
+  void _copy(const rect_t& area, uint8_t* img, bool restore);
+
+public:
+  /**
+   * @brief Construct a new u8g2 render cache object
+   * 
+   * @param u8g2 display object
+   * @param budget max memory for cached images, bytes
+   */
+  u8g2_render_cache(u8g2_t& u8g2, size_t budget = MUIPP_RENDER_CACHE_SIZE) : _u8g2(u8g2), _budget(budget) {}
+
+  bool restore(const MuiItem& item, muiItemId page_id) override;
+  void save(const MuiItem& item, muiItemId page_id) override;
+  void drop(muiItemId item_id) override;
+  void clear() override { _entries.clear(); _size = 0; }
+
+  // total size of cached images, bytes
+  size_t size() const { return _size; }
+};
+
+/**
+ * @brief precomputed line-break layout for word-wrapped text
+ * line breaks are calculated once for a given text, font and position and stored as offsets into the text,
+ * subsequent renders just print whole lines. Layout is rebuilt if text content, font or position changes
+ * 
+ */
+class u8g2_text_layout {
+  struct line_t {
+    uint16_t offset, len;
+  };
+  std::vector<line_t> _lines;
+  // layout keys
+  const char* _text{nullptr};
+  const uint8_t* _font{nullptr};
+  uint32_t _hash{0};
+  u8g2_uint_t _x{0}, _max_x{0};
+
+  void _build(u8g2_t &u8g2, const char* text, u8g2_uint_t x, u8g2_uint_t max_x);
+
+public:
+  /**
+   * @brief print text on multiple lines, keeping words intact where possible and accepting \n to force a new line
+   * first line is printed from x position, all other lines - from the left edge of the screen
+   * 
+   * @param u8g2 display object
+   * @param text text to print
+   * @param x, y cursor position for the first line
+   * @param max_x right edge to wrap lines at
+   * @return int baseline y of the last printed line
+   */
+  int print(u8g2_t &u8g2, const char* text, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t max_x);
+
+  // drop layout, it will be rebuilt on next print
+  void reset(){ _lines.clear(); _text = nullptr; }
+};
+
+} // end of namespace muipp
+
 /**
  * @brief this item will print current page title at top left corner by default
  * title string will be passed here by MuiPlusPlus class renderer
@@ -106,7 +281,8 @@ public:
 
   //~MuiItem_U8g2_PageTitle(){ Serial.println("d-tor PTitle"); }
 
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
+  bool cacheable() const override { return true; }
 };
 
 class MuiItem_U8g2_StaticText : public Item_U8g2_Generic, public MuiItem_Uncontrollable {
@@ -123,7 +299,11 @@ public:
     : Item_U8g2_Generic(u8g2, font, x, y),
       MuiItem_Uncontrollable(id, txt) {};
 
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
+  bool cacheable() const override { return true; }
+
+private:
+  muipp::u8g2_text_layout _layout;
 };
 
 
@@ -145,7 +325,39 @@ public:
         : Item_U8g2_Generic(u8g2, font, x, y),
           MuiItem_Uncontrollable(id), _cb(callback) {};
 
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
+};
+
+/**
+ * @brief profiler overlay
+ * prints items/operations that took most time, one per line as "<kind><id> <avg>/<max>" in microseconds,
+ * where kind is R - item render, E - event, F - frame, S - flush
+ * text is refreshed periodically, item could be added to any page while chasing slow widgets
+ */
+class MuiItem_U8g2_ProfilerOverlay : public Item_U8g2_Generic, public MuiItem_Uncontrollable {
+  const muipp::profiler& _prof;
+  uint8_t _rows;
+  uint16_t _period;
+  uint32_t _last{0};
+public:
+  /**
+   * @brief Construct a new MuiItem_U8g2_ProfilerOverlay object
+   * 
+   * @param u8g2 refernce to display object
+   * @param id assigned id for the item
+   * @param prof profiler to show statistics from, i.e. MuiPlusPlus::profiler()
+   * @param font use font for printing, if null, then do not switch font
+   * @param x, y Coordinates of the first line
+   * @param rows number of lines to print, sorted by max time
+   * @param period refresh period, ms
+   */
+  MuiItem_U8g2_ProfilerOverlay(u8g2_t &u8g2, muiItemId id, const muipp::profiler& prof, const uint8_t* font = nullptr,
+      u8g2_uint_t x = 0, u8g2_uint_t y = 0, uint8_t rows = 3, uint16_t period = 500)
+    : Item_U8g2_Generic(u8g2, font, x, y),
+      MuiItem_Uncontrollable(id), _prof(prof), _rows(rows), _period(period) {};
+
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
+  bool refresh_req() const override { return refresh || muipp::clock_ms() - _last >= _period; }
 };
 
 /**
@@ -170,7 +382,9 @@ public:
       MuiItem(id, lbl, {false, false}), _action(onAction) {};
 
   // render method
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
+  // button is redrawn only on focus changes
+  bool cacheable() const override { return true; }
 
   // event handler
   mui_event muiEvent(mui_event e) override;
@@ -194,6 +408,16 @@ struct dynlist_options_t {
   bool page_selector{false};
   // last element of a list acts as 'previous page' event
   bool back_on_last{false};
+  /**
+   * @brief keep labels of visible rows between renders, so that label callback is called only for rows
+   * that were scrolled into view. Off by default, enable it only if each pointer returned by label callback
+   * stays valid and unchanged until list is reloaded, i.e. labels are static strings or entries of a container.
+   * Callbacks that print into a shared or reused buffer (snprintf into a static array) must leave it off,
+   * otherwise every visible row would show the same text
+   */
+  bool cache_labels{false};
+  // smooth scrolling animation duration in ms, list jumps to new position if 0
+  uint16_t scroll_time{0};
 };
 
 /**
@@ -211,16 +435,44 @@ struct dynlist_options_t {
  * @note if 'opts.page_selector' flag is set, then list will act as a page switcher,
  * i.e. on 'enter' event it will try to switch to a page with name matching to selected list label
  * @note if 'opts.back_on_last' flag is set, then last element of a list will act 'back' event and switch to a previous page
+ * @note list is virtualized - data source size is cached and labels are fetched only for visible rows,
+ * so it could be used for large data sources. 'value' event jumps to an absolute index, 'pageUp'/'pageDown' events move by a number of visible rows
+ * @note if 'opts.scroll_time' is set, list scrolls smoothly, animation frames are rendered on MuiPlusPlus::refresh() calls
  * 
  */
 class MuiItem_U8g2_DynamicScrollList : public Item_U8g2_Generic, public MuiItem {
   muipp::stringbyindex_cb_t _cb;
   muipp::size_cb_t _size_cb;
   muipp::index_cb_t _action;
+  // data source change detection hook
+  muipp::value_cb_t<uint32_t> _version_cb;
   int _y_shift, _num_of_rows;
   const uint8_t *_font2;
   // current list index
   int _index{0};
+  // snapshot of data source size, negative if not fetched yet
+  int _size{-1};
+  // data source version the snapshot was taken for
+  uint32_t _version{0};
+  // window of prefetched labels for visible rows, starting from _win_start index
+  std::vector<const char*> _labels;
+  int _win_start{-1}, _win_len{0};
+  // scrolling animation, pixel offsets of list rows and of highlighted row from their target positions
+  muipp::tween_t _scroll, _hl;
+  // offsets and time of the last rendered frame
+  int32_t _last_so{0}, _last_ho{0};
+  uint32_t _last_frame{0};
+
+  // returns cached size of a data source
+  int _count();
+  // index of the first visible row when list is positioned at specified index
+  int _first_row(int index){ int size = _count(); return muipp::clamp(index - _num_of_rows/2, 0, size ? size - 1 : 0); }
+  // start scrolling animation from a previous list position
+  void _animate(int old_index);
+  // fetch labels for rows [first, first+rows), reusing labels that are already in a window
+  void _fetch_window(int first, int rows);
+  // drop size snapshot and labels window
+  void _invalidate(){ _size = -1; _win_start = -1; _win_len = 0; }
 
 public:
   /**
@@ -254,10 +506,32 @@ public:
   // list options
   dynlist_options_t listopts;
 
+  /**
+   * @brief drop cached data source size and labels, those will be re-read on next render
+   * should be called when data source has been changed, list is reloaded automatically when it receives focus
+   */
+  void reload(){ _invalidate(); refresh = true; }
+
+  /**
+   * @brief set data source change detection hook
+   * callback should return a counter that changes each time data source is modified (i.e. a number of records appended to a log),
+   * it is polled on each MuiPlusPlus::refresh() call and list is reloaded and redrawn when returned value differs from the last seen one
+   * 
+   * @param cb version callback
+   */
+  void setVersionCallback(muipp::value_cb_t<uint32_t> cb){ _version_cb = cb; _version = _version_cb ? _version_cb() : 0; }
+
+  // get current list index
+  size_t getIndex() const { return _index; }
+
   // event handler
   mui_event muiEvent(mui_event e) override;
+  // list could move by a number of positions at once
+  bool acceptsStep() const override { return true; }
+  // list needs a redraw if it's data source has been changed or scrolling animation is running
+  bool refresh_req() const override;
 
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
 };
 
 /**
@@ -283,7 +557,7 @@ public:
       MuiItem(id, label, {false, false}),_v(value), _action(action_cb){}
 
   // render method
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
   // event handler
   mui_event muiEvent(mui_event e) override;
 };
@@ -296,11 +570,23 @@ class MuiItem_U8g2_NumberHSlide : public Item_U8g2_Generic, public MuiItem {
   T& _v;
   T _minv, _maxv, _step;
   muipp::stringify_cb_t<T>     _mkstring;
+  muipp::format_cb_t<T>        _format;
   muipp::constrain_val_cb_t<T> _onSelect;
   muipp::constrain_val_cb_t<T> _onDeSelect;
   muipp::constrain_val_cb_t<T> _onChange;
   const uint8_t* _font2;   // font for minor values
   u8g2_uint_t _offset;
+  // formatted strings for previous, current and next values, kept until value changes
+  char _str[3][MUIPP_NUMBER_STR_LEN];
+  T _str_v{};
+  bool _str_valid{false};
+
+  // change value by a number of steps
+  void _change(int32_t steps);
+  // print value into a buffer
+  void _print(T value, char* buf);
+  // update formatted strings if value has been changed
+  void _update_strings();
 
   void _rndr_unformatted(const MuiItem* parent);
   void _rndr_formatted(const MuiItem* parent);
@@ -344,23 +630,42 @@ public:
 
   //~MuiItem_U8g2_NumberHSlide(){ Serial.println("d-tor HSlide"); }
 
+  // number of digits after decimal point for floating point values printed without formatting callbacks
+  uint8_t decimals{6};
+
+  // value change acceleration on fast input, disabled by default
+  muipp::accelerator_t accel;
+
+  /**
+   * @brief set formatting function that prints value into a buffer
+   * it is used instead of makeString callback and does not allocate memory
+   * 
+   * @param f formatting callback
+   */
+  void setFormatter(muipp::format_cb_t<T> f){ _format = f; _str_valid = false; refresh = true; }
+
   // render method
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
   // event handler
   mui_event muiEvent(mui_event e) override;
+  // slider could change value by a number of steps at once
+  bool acceptsStep() const override { return true; }
 };
 
 
 class MuiItem_U8g2_ValuesList : public Item_U8g2_Generic, public MuiItem {
   // callbacks
   muipp::string_cb_t _getCurrent;
-  std::function< void (void)> _onNext;
-  std::function< void (void)> _onPrev;
+  muipp::action_cb_t _onNext;
+  muipp::action_cb_t _onPrev;
   // cursor x position for value 
   u8g2_uint_t _xval;
   // value horizontal alignment
   muipp::text_align_t _val_halign;
 
+  // switch value by a number of steps
+  void _change(int32_t steps);
+
 public:
 
   MuiItem_U8g2_ValuesList(
@@ -368,8 +673,8 @@ public:
     muiItemId id,
     const char* label,
     muipp::string_cb_t getCurrent,
-    std::function< void (void)> onNext,
-    std::function< void (void)> onPrevious,
+    muipp::action_cb_t onNext,
+    muipp::action_cb_t onPrevious,
     u8g2_uint_t xlbl, u8g2_uint_t xval,
     u8g2_uint_t y,
     const uint8_t* font = nullptr,
@@ -379,10 +684,15 @@ public:
   ) : Item_U8g2_Generic(u8g2, font, xlbl, y, lbl, valign),
       MuiItem(id, label), _getCurrent(getCurrent), _onNext(onNext), _onPrev(onPrevious), _xval(xval), _val_halign(val_halign) {}
 
+  // value change acceleration on fast input, disabled by default
+  muipp::accelerator_t accel;
+
   // render method
-  void render(const MuiItem* parent, void* r = nullptr) override;
+  void render(const MuiItem* parent, muipp::renderer_ref r = {}) override;
   // event handler
   mui_event muiEvent(mui_event e) override;
+  // list could switch a number of values at once
+  bool acceptsStep() const override { return true; }
 };
 
 // ***********************************
@@ -391,39 +701,82 @@ public:
 
 // ***********************************
 template <typename T>
-void MuiItem_U8g2_NumberHSlide<T>::render(const MuiItem* parent, void* r){
+void MuiItem_U8g2_NumberHSlide<T>::_print(T value, char* buf){
+  if (_format){
+    size_t len = _format(value, buf, MUIPP_NUMBER_STR_LEN);
+    buf[std::min<size_t>(len, MUIPP_NUMBER_STR_LEN - 1)] = 0;
+  } else if (_mkstring){
+    std::string str(_mkstring(value));
+    size_t len = str.copy(buf, MUIPP_NUMBER_STR_LEN - 1);
+    buf[len] = 0;
+  } else
+    muipp::format_number(buf, MUIPP_NUMBER_STR_LEN, value, decimals);
+}
+
+template <typename T>
+void MuiItem_U8g2_NumberHSlide<T>::_update_strings(){
+  if (_str_valid && _str_v == _v) return;
+  _str_v = _v;
+  _str_valid = true;
+  _print(_v, _str[1]);
+  // neighbouring values are printed only if those are in range
+  _str[0][0] = _str[2][0] = 0;
+  if (_minv != _maxv){
+    if ((_v - _step) >= _minv)
+      _print(_v - _step, _str[0]);
+    if (_v + _step <= _maxv)
+      _print(_v + _step, _str[2]);
+  }
+}
+
+template <typename T>
+void MuiItem_U8g2_NumberHSlide<T>::render(const MuiItem* parent, muipp::renderer_ref r){
   u8g2_SetFontPosCenter(&_u8g2);
-  std::string val_str(_mkstring ? _mkstring(_v) : std::to_string(_v) );
+  _update_strings();
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
-  auto vlen = u8g2_GetStrWidth(&_u8g2, val_str.data());
+  auto vlen = getTextWidth(_str[1]);
 
   // check if prev value step is valid, then print it
-  if ( (_minv != _maxv) && ((_v - _step) >= _minv) ){
+  if (_str[0][0]){
     if (_font2)
       u8g2_SetFont(&_u8g2, _font2);
 
-    std::string pval_str(_mkstring ? _mkstring(_v - _step) : std::to_string(_v - _step));
-    auto prevx = _x - vlen/2 - _offset - u8g2_GetStrWidth(&_u8g2, pval_str.data());
-    u8g2_DrawStr(&_u8g2, prevx, _y, pval_str.data());
+    auto prevx = _x - vlen/2 - _offset - getTextWidth(_str[0]);
+    u8g2_DrawStr(&_u8g2, prevx, _y, _str[0]);
   }
 
   // print value string
   if (_font)
     u8g2_SetFont(&_u8g2, _font);
 
-  u8g2_DrawButtonUTF8(&_u8g2, _x - vlen/2, _y, U8G2_BTN_INV, 0, 1, 1, val_str.data());
+  u8g2_DrawButtonUTF8(&_u8g2, _x - vlen/2, _y, U8G2_BTN_INV, 0, 1, 1, _str[1]);
 
 
   // check if next value step is valid, then print it
-  if ( (_minv != _maxv) && (_v + _step <= _maxv)){
+  if (_str[2][0]){
     if (_font2)
       u8g2_SetFont(&_u8g2, _font2);
-    
-    std::string nval_str( _mkstring ? _mkstring(_v + _step) : std::to_string(_v + _step));
-    u8g2_DrawStr(&_u8g2, _x + vlen/2 + _offset, _y, nval_str.data());
-   
+
+    u8g2_DrawStr(&_u8g2, _x + vlen/2 + _offset, _y, _str[2]);
   }
+
+  // slider takes the whole line across the screen
+  if (_font)
+    u8g2_SetFont(&_u8g2, _font);
+  bbox = textBox(0, _y, u8g2_GetDisplayWidth(&_u8g2), muipp::text_align_t::center, 2);
+  refresh = false;
+}
+
+template <typename T>
+void MuiItem_U8g2_NumberHSlide<T>::_change(int32_t steps){
+  steps = accel.apply(steps, muipp::clock_ms());
+  // calculate in a wide type, so that accelerated or coalesced steps do not wrap around narrow types before clamping
+  using wide_t = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+  wide_t v = static_cast<wide_t>(_v) + static_cast<wide_t>(steps) * static_cast<wide_t>(_step);
+  if (_minv != _maxv)
+    v = muipp::clamp<wide_t>(v, _minv, _maxv);
+  _v = static_cast<T>(v);
 }
 
 template <typename T>
@@ -432,13 +785,19 @@ mui_event MuiItem_U8g2_NumberHSlide<T>::muiEvent(mui_event e){
     // cursor actions - incr/decr value
     case mui_event_t::moveUp :
     case mui_event_t::moveLeft : {
-      _v = (_minv != _maxv) ? muipp::clamp(_v - _step, _minv, _maxv) : _v - _step;
+      _change(-1);
       break;
     }
     // cursor actions - incr/decr value
     case mui_event_t::moveDown :
     case mui_event_t::moveRight : {
-      _v = (_minv != _maxv) ? muipp::clamp(_v + _step, _minv, _maxv) : _v + _step;
+      _change(1);
+      break;
+    }
+
+    // relative change by a number of steps
+    case mui_event_t::step : {
+      _change(e.param);
       break;
     }
 
@@ -453,8 +812,13 @@ mui_event MuiItem_U8g2_NumberHSlide<T>::muiEvent(mui_event e){
       return mui_event(on_escape);
       break;
     }
+
+    default:
+      return {};
   }
 
+  // value has been changed
+  refresh = true;
   // no-op
   return {};
 }